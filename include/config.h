@@ -13,6 +13,13 @@
 // API Server Settings
 #define API_PORT 80
 
+// FreeSleep Zones
+#define MAX_ZONES 4                 // Setpoints (pod + side) one dial can drive; at most 8
+
+// FreeSleep Controller Discovery (mDNS / DNS-SD)
+#define MDNS_HOSTNAME "rotarydial"          // This dial's mDNS name
+#define FREESLEEP_MDNS_SERVICE "freesleep"  // Controllers advertise _freesleep._tcp
+
 // Display Settings
 #define SCREEN_WIDTH 240
 #define SCREEN_HEIGHT 240
@@ -22,6 +29,7 @@
 #define DIM_TIMEOUT_MS 10000        // Dim after 10 seconds of inactivity
 #define NIGHT_START_HOUR 22         // 10pm
 #define NIGHT_END_HOUR 7            // 7am
+#define EVENING_START_HOUR 20       // 8pm - low-blue theme until night mode starts
 
 // NTP Settings
 #define NTP_SERVER "pool.ntp.org"
@@ -36,6 +44,7 @@
 #define COLOR_ARC_HOT 0xF800       // Red
 #define COLOR_TEXT 0xFFFF          // White
 #define COLOR_SETPOINT 0x07E0      // Green
+#define COLOR_DIM_TEXT 0x4208      // Dark gray (inactive menu items)
 
 // Night Mode Colors (RGB565 format - red theme)
 #define COLOR_NIGHT_BACKGROUND 0x0000    // Black
@@ -45,5 +54,16 @@
 #define COLOR_NIGHT_ARC_HOT 0xF800       // Bright red
 #define COLOR_NIGHT_TEXT 0xF800          // Red text
 #define COLOR_NIGHT_SETPOINT 0xC000      // Dark orange-red
+#define COLOR_NIGHT_DIM_TEXT 0x4000      // Dark red (inactive menu items)
+
+// Evening Mode Colors (RGB565 format - low-blue amber theme)
+#define COLOR_EVENING_BACKGROUND 0x0000  // Black
+#define COLOR_EVENING_ARC_BG 0x30C0      // Very dark amber
+#define COLOR_EVENING_ARC_COLD 0x8200    // Dark amber
+#define COLOR_EVENING_ARC_WARM 0xFC00    // Orange
+#define COLOR_EVENING_ARC_HOT 0xF980     // Red-orange
+#define COLOR_EVENING_TEXT 0xFD80        // Amber text
+#define COLOR_EVENING_SETPOINT 0xFC80    // Deep amber
+#define COLOR_EVENING_DIM_TEXT 0x4940    // Dim amber (inactive menu items)
 
 #endif // CONFIG_H
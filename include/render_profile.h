@@ -0,0 +1,80 @@
+#ifndef RENDER_PROFILE_H
+#define RENDER_PROFILE_H
+
+#include <stdint.h>
+#include "config.h"
+#include "theme.h"
+
+// Render profiling - frame timing, drawing calls and display traffic per screen.
+// Exposed on /api/debug/render-stats; /api/debug/render-bench runs a fixed matrix.
+// Shared with the host benchmark (native/bench), which runs the same matrix off-device.
+enum RenderScreen {
+    RENDER_TEMPERATURE = 0,
+    RENDER_SETTINGS,
+    RENDER_IP_EDITOR,
+    RENDER_WIFI_SCANNER,
+    RENDER_PASSWORD,
+    RENDER_AMBIENT,
+    RENDER_PARTIAL,  // Clock, marquee and press-ring updates that bypass the full frame
+    RENDER_SCREEN_COUNT
+};
+
+const char* const RENDER_SCREEN_NAMES[RENDER_SCREEN_COUNT] = {
+    "temperature", "settings", "ipEditor", "wifiScanner", "password", "ambient", "partial"
+};
+
+struct RenderStats {
+    uint32_t frames;
+    uint64_t rasterMicros;   // Time spent drawing into the sprite
+    uint64_t pushMicros;     // Time spent sending pixels to the display
+    uint32_t maxFrameMicros;
+    uint64_t pixelsPushed;
+    uint64_t primitives;     // Drawing calls made on the sprite
+    uint64_t dirtyPixels;    // Pixels in tiles that differ from the previous frame
+};
+
+// Render benchmark - a POST fills in the cases and loop() renders one per pass, so input,
+// the web server and FreeSleep results are still handled between them; a GET reads it back
+enum RenderBenchState {
+    RENDER_BENCH_IDLE,     // Never run
+    RENDER_BENCH_RUNNING,
+    RENDER_BENCH_DONE
+};
+
+const char* const RENDER_BENCH_STATE_NAMES[] = {"idle", "running", "done"};
+const char* const RENDER_THEME_NAMES[THEME_COUNT] = {"day", "evening", "night"};
+const int RENDER_BENCH_FRAMES = 3;  // Frames averaged per benchmark case
+const int RENDER_BENCH_SETPOINTS = 3;
+// Every screen in every theme, and the main screen in both units at each setpoint
+const int RENDER_BENCH_CASES = THEME_COUNT * (RENDER_PARTIAL - 1 + 2 * RENDER_BENCH_SETPOINTS);
+
+struct RenderBenchCase {
+    RenderScreen screen;
+    ThemeId theme;
+    bool fahrenheit;
+    float setpoint;        // Main screen only; other screens render the current setpoint
+    uint32_t rasterMicros; // Per frame
+    uint32_t pushMicros;
+    uint32_t maxFrameMicros;
+    uint32_t pixelsPerFrame;
+    uint32_t primitivesPerFrame;
+    uint32_t dirtyPixels;  // Across the case's frames - only the first differs from the case before
+};
+
+struct RenderBench {
+    RenderBenchCase cases[RENDER_BENCH_CASES];
+    int next;              // Case the next loop pass renders
+    unsigned long startedAt;
+    unsigned long finishedAt;
+};
+
+extern RenderStats renderStats[RENDER_SCREEN_COUNT];
+extern RenderBench renderBench;
+extern RenderBenchState renderBenchState;
+extern bool renderDirtyTracking;  // Count dirtyPixels outside a benchmark (costs a pass over every frame)
+
+void startRenderBench();
+void runRenderBenchCase(RenderBenchCase& benchCase);
+void renderScreen(RenderScreen screen);
+
+#endif // RENDER_PROFILE_H
@@ -0,0 +1,125 @@
+#ifndef THEME_H
+#define THEME_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Colour themes as constexpr policy types.
+// Each policy supplies its palette (from config.h) and an arc gradient function;
+// makeTheme<>() bakes both into a flat Theme table at compile time, so the
+// draw functions just index the active table - no per-pixel colour maths and
+// no day/night branching. Adding a theme is a new policy plus a THEMES entry.
+
+constexpr uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+// Temperature arc geometry (screen coords: 0°=3 o'clock, 90°=6 o'clock)
+// Runs from 8:30 to 3:30 going clockwise, drawn as one radial line every 2°
+constexpr int ARC_START_ANGLE = 165;
+constexpr int ARC_END_ANGLE = 375;  // Wraps around 360°
+constexpr int ARC_ANGLE_STEP = 2;
+constexpr int ARC_TOTAL_DEGREES = ARC_END_ANGLE - ARC_START_ANGLE;  // 210 degrees
+constexpr int ARC_GRADIENT_STEPS = ARC_TOTAL_DEGREES / ARC_ANGLE_STEP + 1;
+
+// Day: blue -> cyan -> green -> yellow -> orange -> red
+struct DayTheme {
+    static constexpr uint16_t background = COLOR_BACKGROUND;
+    static constexpr uint16_t arcBg = COLOR_ARC_BG;
+    static constexpr uint16_t arcCold = COLOR_ARC_COLD;
+    static constexpr uint16_t arcWarm = COLOR_ARC_WARM;
+    static constexpr uint16_t arcHot = COLOR_ARC_HOT;
+    static constexpr uint16_t text = COLOR_TEXT;
+    static constexpr uint16_t setpoint = COLOR_SETPOINT;
+    static constexpr uint16_t dimText = COLOR_DIM_TEXT;
+
+    static constexpr uint16_t gradient(float percent) {
+        if (percent < 0.25f) {
+            // Blue to Cyan
+            return rgb565(0, (uint8_t)(255 * (percent / 0.25f)), 255);
+        } else if (percent < 0.5f) {
+            // Cyan to Green
+            return rgb565(0, 255, (uint8_t)(255 * (1 - (percent - 0.25f) / 0.25f)));
+        } else if (percent < 0.75f) {
+            // Green to Yellow/Orange
+            return rgb565((uint8_t)(255 * ((percent - 0.5f) / 0.25f)), 255, 0);
+        }
+        // Orange to Red
+        return rgb565(255, (uint8_t)(255 * (1 - (percent - 0.75f) / 0.25f)), 0);
+    }
+};
+
+// Evening: amber ramp with no blue component
+struct EveningTheme {
+    static constexpr uint16_t background = COLOR_EVENING_BACKGROUND;
+    static constexpr uint16_t arcBg = COLOR_EVENING_ARC_BG;
+    static constexpr uint16_t arcCold = COLOR_EVENING_ARC_COLD;
+    static constexpr uint16_t arcWarm = COLOR_EVENING_ARC_WARM;
+    static constexpr uint16_t arcHot = COLOR_EVENING_ARC_HOT;
+    static constexpr uint16_t text = COLOR_EVENING_TEXT;
+    static constexpr uint16_t setpoint = COLOR_EVENING_SETPOINT;
+    static constexpr uint16_t dimText = COLOR_EVENING_DIM_TEXT;
+
+    static constexpr uint16_t gradient(float percent) {
+        // Dark amber (96, 64, 0) to red-orange (255, 32, 0)
+        return rgb565((uint8_t)(96 + 159 * percent), (uint8_t)(64 + 96 * percent - 128 * percent * percent), 0);
+    }
+};
+
+// Night: red only, dark red -> bright red
+struct NightTheme {
+    static constexpr uint16_t background = COLOR_NIGHT_BACKGROUND;
+    static constexpr uint16_t arcBg = COLOR_NIGHT_ARC_BG;
+    static constexpr uint16_t arcCold = COLOR_NIGHT_ARC_COLD;
+    static constexpr uint16_t arcWarm = COLOR_NIGHT_ARC_WARM;
+    static constexpr uint16_t arcHot = COLOR_NIGHT_ARC_HOT;
+    static constexpr uint16_t text = COLOR_NIGHT_TEXT;
+    static constexpr uint16_t setpoint = COLOR_NIGHT_SETPOINT;
+    static constexpr uint16_t dimText = COLOR_NIGHT_DIM_TEXT;
+
+    static constexpr uint16_t gradient(float percent) {
+        // Dark red (64, 0, 0) to bright red (255, 0, 0)
+        return rgb565((uint8_t)(64 + 191 * percent), 0, 0);
+    }
+};
+
+// Flattened theme as used by the draw functions
+struct Theme {
+    uint16_t background;
+    uint16_t arcBg;
+    uint16_t arcCold;
+    uint16_t arcWarm;
+    uint16_t arcHot;
+    uint16_t text;
+    uint16_t setpoint;
+    uint16_t dimText;
+    uint16_t arcGradient[ARC_GRADIENT_STEPS];  // One colour per arc line, start to end
+};
+
+template <typename Policy>
+constexpr Theme makeTheme() {
+    Theme theme = {Policy::background, Policy::arcBg, Policy::arcCold, Policy::arcWarm,
+                   Policy::arcHot, Policy::text, Policy::setpoint, Policy::dimText, {}};
+    for (int i = 0; i < ARC_GRADIENT_STEPS; i++) {
+        theme.arcGradient[i] = Policy::gradient((float)(i * ARC_ANGLE_STEP) / ARC_TOTAL_DEGREES);
+    }
+    return theme;
+}
+
+enum ThemeId {
+    THEME_DAY = 0,
+    THEME_EVENING,
+    THEME_NIGHT,
+    THEME_COUNT
+};
+
+// Generated at compile time and placed in flash
+inline constexpr Theme THEMES[THEME_COUNT] = {
+    makeTheme<DayTheme>(),
+    makeTheme<EveningTheme>(),
+    makeTheme<NightTheme>(),
+};
+
+static_assert(THEMES[THEME_NIGHT].arcGradient[0] == rgb565(64, 0, 0), "theme tables must be built at compile time");
+
+#endif // THEME_H
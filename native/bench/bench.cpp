@@ -0,0 +1,172 @@
+// The render benchmark as a host program: the same screen x theme x setpoint x unit matrix
+// as POST /api/debug/render-bench, drawn into the RGB565 framebuffer fake of the display.
+// Prints time per frame, drawing calls, pixels drawn (overdraw included), pixels pushed and
+// dirty pixels per case, writes them to results.csv and dumps each case's last frame as a PNG.
+//
+//   .pio/build/native-bench/program [--out DIR]   (default .pio/render-bench)
+//
+// Times are host CPU times - useful to compare cases and commits, not as device frame times.
+// Primitive and pixel counts are the same as on the dial.
+
+#include <Arduino.h>
+#include <M5Dial.h>
+#include <filesystem>
+#include <string>
+#include "render_profile.h"
+
+void loadSettings();
+void setupDisplay();
+
+namespace {
+
+uint32_t crcTable[256];
+
+void buildCrcTable() {
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crcTable[n] = c;
+    }
+}
+
+uint32_t crc32(const std::string& data) {
+    uint32_t c = 0xFFFFFFFFu;
+    for (unsigned char byte : data) c = crcTable[(c ^ byte) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+void putBigEndian(std::string& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) out += (char)(value >> shift);
+}
+
+void writeChunk(FILE* file, const char* type, const std::string& data) {
+    std::string chunk(type, 4);
+    chunk += data;
+    std::string length;
+    putBigEndian(length, data.size());
+    std::string crc;
+    putBigEndian(crc, crc32(chunk));
+    fwrite(length.data(), 1, length.size(), file);
+    fwrite(chunk.data(), 1, chunk.size(), file);
+    fwrite(crc.data(), 1, crc.size(), file);
+}
+
+// 8-bit RGB PNG of an RGB565 frame. The zlib stream uses stored (uncompressed) blocks,
+// so no compression library is needed.
+bool writePng(const std::string& path, const uint16_t* pixels, int width, int height) {
+    std::string raw;
+    raw.reserve((size_t)height * (1 + width * 3));
+    for (int y = 0; y < height; y++) {
+        raw += (char)0;  // Filter: none
+        for (int x = 0; x < width; x++) {
+            uint16_t color = pixels[y * width + x];
+            uint8_t r = (color >> 11) & 0x1F, g = (color >> 5) & 0x3F, b = color & 0x1F;
+            raw += (char)((r << 3) | (r >> 2));
+            raw += (char)((g << 2) | (g >> 4));
+            raw += (char)((b << 3) | (b >> 2));
+        }
+    }
+
+    std::string zlib = "\x78\x01";
+    uint32_t adlerA = 1, adlerB = 0;
+    for (unsigned char byte : raw) {
+        adlerA = (adlerA + byte) % 65521;
+        adlerB = (adlerB + adlerA) % 65521;
+    }
+    for (size_t offset = 0; offset < raw.size() || offset == 0; offset += 65535) {
+        size_t length = std::min(raw.size() - offset, (size_t)65535);
+        bool last = offset + length == raw.size();
+        zlib += (char)(last ? 1 : 0);
+        zlib += (char)(length & 0xFF);
+        zlib += (char)(length >> 8);
+        zlib += (char)(~length & 0xFF);
+        zlib += (char)((~length >> 8) & 0xFF);
+        zlib.append(raw, offset, length);
+        if (last) break;
+    }
+    putBigEndian(zlib, (adlerB << 16) | adlerA);
+
+    std::string header;
+    putBigEndian(header, width);
+    putBigEndian(header, height);
+    header += std::string("\x08\x02\x00\x00\x00", 5);  // 8-bit RGB, no interlace
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    fwrite("\x89PNG\r\n\x1a\n", 1, 8, file);
+    writeChunk(file, "IHDR", header);
+    writeChunk(file, "IDAT", zlib);
+    writeChunk(file, "IEND", "");
+    return fclose(file) == 0;
+}
+
+// temperature-day-C-21.0, settings-night, ...
+std::string caseName(const RenderBenchCase& benchCase) {
+    std::string name = std::string(RENDER_SCREEN_NAMES[benchCase.screen]) + "-" + RENDER_THEME_NAMES[benchCase.theme];
+    if (benchCase.screen == RENDER_TEMPERATURE) {
+        char suffix[16];
+        snprintf(suffix, sizeof(suffix), "-%c-%.1f", benchCase.fahrenheit ? 'F' : 'C', benchCase.setpoint);
+        name += suffix;
+    }
+    return name;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string outDir = ".pio/render-bench";
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+            outDir = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--out DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+    std::error_code error;
+    std::filesystem::create_directories(outDir, error);
+    if (error) {
+        fprintf(stderr, "can't create %s: %s\n", outDir.c_str(), error.message().c_str());
+        return 1;
+    }
+    buildCrcTable();
+
+    loadSettings();
+    setupDisplay();
+    startRenderBench();
+
+    std::string csv = "case,screen,theme,unit,setpoint,rasterUs,pushUs,maxFrameUs,primitives,pixelsDrawn,pixelsPushed,dirtyPixels\n";
+    printf("%-28s %9s %7s %10s %11s %11s %11s\n",
+           "case", "rasterUs", "pushUs", "primitives", "drawn/frame", "pushed", "dirty");
+    for (RenderBenchCase& benchCase : renderBench.cases) {
+        uint64_t drawnBefore = nativePixelsDrawn;
+        runRenderBenchCase(benchCase);
+        uint32_t pixelsDrawn = (nativePixelsDrawn - drawnBefore) / RENDER_BENCH_FRAMES;
+
+        std::string name = caseName(benchCase);
+        const uint16_t* frame = (const uint16_t*)M5Dial.Display.getBuffer();
+        if (!writePng(outDir + "/" + name + ".png", frame, M5Dial.Display.width(), M5Dial.Display.height())) {
+            fprintf(stderr, "can't write %s/%s.png\n", outDir.c_str(), name.c_str());
+            return 1;
+        }
+
+        printf("%-28s %9u %7u %10u %11u %11u %11u\n", name.c_str(), benchCase.rasterMicros, benchCase.pushMicros,
+               benchCase.primitivesPerFrame, pixelsDrawn, benchCase.pixelsPerFrame, benchCase.dirtyPixels);
+        char row[256];
+        snprintf(row, sizeof(row), "%s,%s,%s,%c,%.1f,%u,%u,%u,%u,%u,%u,%u\n", name.c_str(),
+                 RENDER_SCREEN_NAMES[benchCase.screen], RENDER_THEME_NAMES[benchCase.theme],
+                 benchCase.fahrenheit ? 'F' : 'C', benchCase.setpoint, benchCase.rasterMicros, benchCase.pushMicros,
+                 benchCase.maxFrameMicros, benchCase.primitivesPerFrame, pixelsDrawn, benchCase.pixelsPerFrame,
+                 benchCase.dirtyPixels);
+        csv += row;
+    }
+    renderBenchState = RENDER_BENCH_DONE;
+
+    FILE* file = fopen((outDir + "/results.csv").c_str(), "w");
+    if (!file || fwrite(csv.data(), 1, csv.size(), file) != csv.size() || fclose(file) != 0) {
+        fprintf(stderr, "can't write %s/results.csv\n", outDir.c_str());
+        return 1;
+    }
+    printf("\n%d cases; frames and results.csv in %s\n", RENDER_BENCH_CASES, outDir.c_str());
+    return 0;
+}
@@ -0,0 +1,210 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+// Host stand-in for the parts of the Arduino-ESP32 core the firmware uses.
+// Signatures follow the real core so src/main.cpp builds unchanged; see native/README.md.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <string>
+#include <utility>
+
+using std::min;
+using std::max;
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// Not in glibc before 2.38
+size_t nativeStrlcpy(char* dst, const char* src, size_t size);
+#define strlcpy nativeStrlcpy
+
+class String {
+public:
+    String(const char* cstr = "") : value(cstr ? cstr : "") {}
+    String(const char* cstr, size_t length) : value(cstr, length) {}
+    String(const std::string& str) : value(str) {}
+    explicit String(char c) : value(1, c) {}
+    explicit String(int number) : value(std::to_string(number)) {}
+    explicit String(unsigned int number) : value(std::to_string(number)) {}
+    explicit String(long number) : value(std::to_string(number)) {}
+    explicit String(unsigned long number) : value(std::to_string(number)) {}
+    explicit String(float number, unsigned int decimals = 2);
+    explicit String(double number, unsigned int decimals = 2);
+
+    const char* c_str() const { return value.c_str(); }
+    unsigned int length() const { return value.size(); }
+    bool isEmpty() const { return value.empty(); }
+    void reserve(unsigned int size) { value.reserve(size); }
+
+    bool concat(const String& str) { value += str.value; return true; }
+    bool concat(const char* cstr) { if (cstr) value += cstr; return true; }
+    bool concat(char c) { value += c; return true; }
+    String& operator+=(const String& rhs) { concat(rhs); return *this; }
+    String& operator+=(const char* rhs) { concat(rhs); return *this; }
+    String& operator+=(char rhs) { concat(rhs); return *this; }
+    String& operator+=(int rhs) { value += std::to_string(rhs); return *this; }
+    String& operator+=(unsigned int rhs) { value += std::to_string(rhs); return *this; }
+    String& operator+=(long rhs) { value += std::to_string(rhs); return *this; }
+    String& operator+=(unsigned long rhs) { value += std::to_string(rhs); return *this; }
+
+    char operator[](unsigned int index) const { return index < value.size() ? value[index] : 0; }
+    char charAt(unsigned int index) const { return (*this)[index]; }
+    bool equals(const String& str) const { return value == str.value; }
+    bool operator==(const String& rhs) const { return value == rhs.value; }
+    bool operator==(const char* rhs) const { return value == (rhs ? rhs : ""); }
+    bool operator!=(const String& rhs) const { return value != rhs.value; }
+    bool operator!=(const char* rhs) const { return !(*this == rhs); }
+    bool operator<(const String& rhs) const { return value < rhs.value; }
+
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const char* str, unsigned int from = 0) const;
+    int indexOf(const String& str, unsigned int from = 0) const { return indexOf(str.c_str(), from); }
+    bool startsWith(const String& prefix) const { return value.compare(0, prefix.value.size(), prefix.value) == 0; }
+    bool endsWith(const String& suffix) const;
+    String substring(unsigned int left) const { return substring(left, value.size()); }
+    String substring(unsigned int left, unsigned int right) const;
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    long toInt() const { return strtol(value.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(value.c_str(), nullptr); }
+
+private:
+    std::string value;
+};
+
+// ArduinoJson names this type alongside String
+class StringSumHelper : public String {
+public:
+    using String::String;
+    StringSumHelper(const String& str) : String(str) {}
+};
+
+StringSumHelper operator+(const String& lhs, const String& rhs);
+StringSumHelper operator+(const String& lhs, const char* rhs);
+StringSumHelper operator+(const char* lhs, const String& rhs);
+StringSumHelper operator+(const String& lhs, char rhs);
+StringSumHelper operator+(const String& lhs, int rhs);
+StringSumHelper operator+(const String& lhs, unsigned int rhs);
+StringSumHelper operator+(const String& lhs, long rhs);
+StringSumHelper operator+(const String& lhs, unsigned long rhs);
+
+class Print;
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const char* str) { return write(str); }
+    size_t print(const String& str) { return write(str.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int number) { return printf("%d", number); }
+    size_t print(unsigned int number) { return printf("%u", number); }
+    size_t print(long number) { return printf("%ld", number); }
+    size_t print(unsigned long number) { return printf("%lu", number); }
+    size_t print(double number, int digits = 2) { return printf("%.*f", digits, number); }
+    size_t print(const Printable& printable) { return printable.printTo(*this); }
+    size_t print(const struct tm* timeinfo, const char* format = nullptr);
+
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(const T& value) { return print(value) + println(); }
+    size_t println(const char* str) { return print(str) + println(); }
+    size_t println(const struct tm* timeinfo, const char* format = nullptr) { return print(timeinfo, format) + println(); }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual size_t readBytes(char* buffer, size_t length);
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+    void setTimeout(unsigned long timeout) { timeoutMs = timeout; }
+
+protected:
+    unsigned long timeoutMs = 1000;
+};
+
+// Serial goes to stdout
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+
+extern HardwareSerial Serial;
+
+class IPAddress : public Printable {
+public:
+    IPAddress() : address(0) {}
+    IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth);
+    IPAddress(uint32_t address) : address(address) {}
+
+    bool fromString(const char* address);
+    bool fromString(const String& address) { return fromString(address.c_str()); }
+    String toString() const;
+
+    // Network byte order, like the ESP32 core - usable as an in_addr as is
+    operator uint32_t() const { return address; }
+    bool operator==(const IPAddress& rhs) const { return address == rhs.address; }
+    bool operator!=(const IPAddress& rhs) const { return address != rhs.address; }
+    uint8_t operator[](int index) const { return ((const uint8_t*)&address)[index]; }
+    uint8_t& operator[](int index) { return ((uint8_t*)&address)[index]; }
+
+    size_t printTo(Print& p) const override { return p.print(toString()); }
+
+private:
+    uint32_t address;
+};
+
+// The host clock stands in for SNTP
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1,
+                const char* server2 = nullptr, const char* server3 = nullptr);
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+};
+
+extern EspClass ESP;
+
+#endif // NATIVE_ARDUINO_H
@@ -0,0 +1,21 @@
+#ifndef NATIVE_ESPMDNS_H
+#define NATIVE_ESPMDNS_H
+
+// No mDNS on the host: browsing finds nothing, so zones are bound by IP
+
+#include "Arduino.h"
+
+class MDNSResponder {
+public:
+    bool begin(const char* hostName) { (void)hostName; return true; }
+    void end() {}
+    int queryService(const char* service, const char* proto) { (void)service; (void)proto; return 0; }
+    String hostname(int index) { (void)index; return String(); }
+    IPAddress IP(int index) { (void)index; return IPAddress(); }
+    uint16_t port(int index) { (void)index; return 0; }
+    IPAddress queryHost(const char* host, uint32_t timeout = 2000) { (void)host; (void)timeout; return IPAddress(); }
+};
+
+extern MDNSResponder MDNS;
+
+#endif // NATIVE_ESPMDNS_H
@@ -0,0 +1,256 @@
+#ifndef NATIVE_M5DIAL_H
+#define NATIVE_M5DIAL_H
+
+// M5Dial with an in-memory RGB565 framebuffer for the display. The drawing calls follow
+// LovyanGFX (clip rectangle, text datum, transparent or filled text background, colour
+// conversion by argument type); text is drawn from one 5x8 bitmap font scaled to each
+// font's size, so labels land where the real font would put them but look plainer.
+// Input devices are idle unless a harness moves them.
+
+#include "Arduino.h"
+
+namespace lgfx {
+
+// Metrics only - the advance is the average glyph width of the real font
+struct IFont {
+    const char* name;
+    int16_t height;   // Line height in pixels at text size 1
+    int16_t advance;  // Pixels per character at text size 1
+};
+
+}  // namespace lgfx
+
+namespace fonts {
+extern const lgfx::IFont Font0;
+extern const lgfx::IFont Font2;
+extern const lgfx::IFont Font4;
+extern const lgfx::IFont Font7;
+extern const lgfx::IFont FreeSans9pt7b;
+extern const lgfx::IFont FreeSans12pt7b;
+extern const lgfx::IFont FreeSansBold9pt7b;
+extern const lgfx::IFont FreeSansBold12pt7b;
+extern const lgfx::IFont FreeSansBold18pt7b;
+extern const lgfx::IFont FreeSansBold24pt7b;
+}  // namespace fonts
+
+enum textdatum_t : uint8_t {
+    top_left = 0,
+    top_center = 1,
+    top_right = 2,
+    middle_left = 4,
+    middle_center = 5,
+    middle_right = 6,
+    bottom_left = 8,
+    bottom_center = 9,
+    bottom_right = 10,
+    baseline_left = 16,
+    baseline_center = 17,
+    baseline_right = 18
+};
+
+// LovyanGFX picks the colour format from the argument's type
+inline uint16_t nativeColor(uint8_t rgb332) {
+    return ((rgb332 & 0xE0) << 8) | ((rgb332 & 0x1C) << 6) | ((rgb332 & 0x03) << 3);
+}
+inline uint16_t nativeColor(uint16_t rgb565) { return rgb565; }
+inline uint16_t nativeColor(int rgb565) { return (uint16_t)rgb565; }
+inline uint16_t nativeColor(uint32_t rgb888) {
+    return ((rgb888 >> 8) & 0xF800) | ((rgb888 >> 5) & 0x07E0) | ((rgb888 >> 3) & 0x001F);
+}
+
+// Pixels written by drawing calls on any sprite or the display, overdraw included.
+// Pushing a sprite isn't drawing and doesn't count. For the host benchmark (native/bench).
+extern uint64_t nativePixelsDrawn;
+
+class LovyanGFX {
+public:
+    LovyanGFX() {}
+    virtual ~LovyanGFX() {}
+    LovyanGFX(const LovyanGFX&) = delete;
+    LovyanGFX& operator=(const LovyanGFX&) = delete;
+
+    int32_t width() const { return frameWidth; }
+    int32_t height() const { return frameHeight; }
+    void* getBuffer() const { return buffer; }
+    uint16_t readPixel(int32_t x, int32_t y) const;
+
+    void startWrite() {}
+    void endWrite() {}
+    void setClipRect(int32_t x, int32_t y, int32_t w, int32_t h);
+    void clearClipRect() { setClipRect(0, 0, frameWidth, frameHeight); }
+
+    template <typename T> void fillScreen(const T& color) { fillRectRaw(0, 0, frameWidth, frameHeight, nativeColor(color)); }
+    template <typename T> void drawPixel(int32_t x, int32_t y, const T& color) { fillRectRaw(x, y, 1, 1, nativeColor(color)); }
+    template <typename T> void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, const T& color) {
+        fillRectRaw(x, y, w, h, nativeColor(color));
+    }
+    template <typename T> void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, const T& color) {
+        drawRectRaw(x, y, w, h, nativeColor(color));
+    }
+    template <typename T> void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, const T& color) {
+        fillRoundRectRaw(x, y, w, h, r, nativeColor(color));
+    }
+    template <typename T> void fillCircle(int32_t x, int32_t y, int32_t r, const T& color) {
+        fillCircleRaw(x, y, r, nativeColor(color));
+    }
+    template <typename T> void drawCircle(int32_t x, int32_t y, int32_t r, const T& color) {
+        drawCircleRaw(x, y, r, nativeColor(color));
+    }
+    template <typename T> void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const T& color) {
+        drawLineRaw(x0, y0, x1, y1, nativeColor(color));
+    }
+    // Angles in degrees, clockwise from 3 o'clock
+    template <typename T> void fillArc(int32_t x, int32_t y, int32_t r0, int32_t r1, float angle0, float angle1, const T& color) {
+        fillArcRaw(x, y, r0, r1, angle0, angle1, nativeColor(color));
+    }
+
+    void setFont(const lgfx::IFont* font) { textFont = font; }
+    const lgfx::IFont* getFont() const { return textFont; }
+    void setTextSize(float size) { textSize = size; }
+    void setTextDatum(textdatum_t datum) { textDatum = datum; }
+    template <typename T> void setTextColor(const T& color) { textColor = nativeColor(color); textFillBackground = false; }
+    template <typename T, typename U> void setTextColor(const T& color, const U& background) {
+        textColor = nativeColor(color);
+        textBackground = nativeColor(background);
+        textFillBackground = true;
+    }
+    int32_t textWidth(const char* text) const;
+    int32_t textWidth(const String& text) const { return textWidth(text.c_str()); }
+    int32_t fontHeight() const;
+    int32_t drawString(const char* text, int32_t x, int32_t y);
+    int32_t drawString(const String& text, int32_t x, int32_t y) { return drawString(text.c_str(), x, y); }
+
+    void setRotation(uint8_t rotation) { (void)rotation; }
+    void setBrightness(uint8_t level) { brightness = level; }
+    uint8_t getBrightness() const { return brightness; }
+
+protected:
+    friend class LGFX_Sprite;
+
+    void fillRectRaw(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+    void drawRectRaw(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+    void fillRoundRectRaw(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color);
+    void fillCircleRaw(int32_t x, int32_t y, int32_t r, uint16_t color);
+    void drawCircleRaw(int32_t x, int32_t y, int32_t r, uint16_t color);
+    void drawLineRaw(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color);
+    void fillArcRaw(int32_t x, int32_t y, int32_t r0, int32_t r1, float angle0, float angle1, uint16_t color);
+    void plot(int32_t x, int32_t y, uint16_t color);
+    bool inClip(int32_t x, int32_t y) const { return x >= clipLeft && x <= clipRight && y >= clipTop && y <= clipBottom; }
+    void attach(uint16_t* pixels, int32_t w, int32_t h);
+
+    uint16_t* buffer = nullptr;
+    int32_t frameWidth = 0;
+    int32_t frameHeight = 0;
+    int32_t clipLeft = 0, clipTop = 0, clipRight = -1, clipBottom = -1;  // Inclusive
+
+    const lgfx::IFont* textFont = &fonts::Font0;
+    float textSize = 1;
+    textdatum_t textDatum = top_left;
+    uint16_t textColor = 0xFFFF;
+    uint16_t textBackground = 0;
+    bool textFillBackground = false;
+    uint8_t brightness = 255;
+};
+
+// The panel: 240x240, always there
+class M5GFX : public LovyanGFX {
+public:
+    M5GFX();
+
+private:
+    uint16_t panel[240 * 240];
+};
+
+class LGFX_Sprite : public LovyanGFX {
+public:
+    LGFX_Sprite() {}
+    explicit LGFX_Sprite(LovyanGFX* parent) : parent(parent) {}
+    ~LGFX_Sprite() { deleteSprite(); }
+
+    void* createSprite(int32_t w, int32_t h);
+    void deleteSprite();
+    void setPsram(bool enabled) { (void)enabled; }
+    void setColorDepth(int bits) { (void)bits; }
+
+    template <typename T> void fillSprite(const T& color) { fillScreen(color); }
+
+    void pushSprite(int32_t x, int32_t y) { if (parent) pushSprite(parent, x, y); }
+    void pushSprite(LovyanGFX* dst, int32_t x, int32_t y) const { copyTo(dst, x, y, false, 0); }
+    template <typename T> void pushSprite(int32_t x, int32_t y, const T& transparent) {
+        if (parent) pushSprite(parent, x, y, transparent);
+    }
+    template <typename T> void pushSprite(LovyanGFX* dst, int32_t x, int32_t y, const T& transparent) const {
+        copyTo(dst, x, y, true, nativeColor(transparent));
+    }
+
+private:
+    void copyTo(LovyanGFX* dst, int32_t x, int32_t y, bool useTransparent, uint16_t transparent) const;
+
+    LovyanGFX* parent = nullptr;
+};
+
+namespace m5 {
+
+struct touch_detail_t {
+    int16_t x = -1;
+    int16_t y = -1;
+    bool pressed = false;
+    bool changed = false;
+
+    bool isPressed() const { return pressed; }
+    bool wasPressed() const { return pressed && changed; }
+    bool wasReleased() const { return !pressed && changed; }
+};
+
+struct Touch_Class {
+    touch_detail_t getDetail() const { return detail; }
+    touch_detail_t detail;
+};
+
+struct Button_Class {
+    bool wasPressed() const { return false; }
+    bool wasReleased() const { return false; }
+    bool isPressed() const { return false; }
+    bool pressedFor(uint32_t ms) const { (void)ms; return false; }
+};
+
+struct RTC8563_Class {
+    void setDateTime(const struct tm* datetime) { (void)datetime; }
+};
+
+struct M5Unified {
+    struct config_t {};
+    config_t config() const { return config_t(); }
+};
+
+}  // namespace m5
+
+// A harness turns the dial with write()
+class ENCODER {
+public:
+    long read() const { return position; }
+    long readAndReset() { long value = position; position = 0; return value; }
+    void write(long value) { position = value; }
+
+private:
+    long position = 0;
+};
+
+class M5_DIAL {
+public:
+    void begin(m5::M5Unified::config_t cfg, bool enableEncoder = false, bool enableRFID = false) {
+        (void)cfg; (void)enableEncoder; (void)enableRFID;
+    }
+    void update() {}
+
+    M5GFX Display;
+    m5::Touch_Class Touch;
+    m5::Button_Class BtnA;
+    m5::RTC8563_Class Rtc;
+    ENCODER Encoder;
+};
+
+extern m5::M5Unified M5;
+extern M5_DIAL M5Dial;
+
+#endif // NATIVE_M5DIAL_H
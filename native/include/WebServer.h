@@ -0,0 +1,80 @@
+#ifndef NATIVE_WEBSERVER_H
+#define NATIVE_WEBSERVER_H
+
+// Minimal HTTP/1.1 server with the ESP32 WebServer's interface. Like the real one it is
+// served from handleClient() on the caller's thread: one request per call, answered and
+// closed, so a slow loop() shows up as slow responses here too.
+
+#include <functional>
+#include <vector>
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+typedef enum {
+    HTTP_ANY,
+    HTTP_GET,
+    HTTP_HEAD,
+    HTTP_POST,
+    HTTP_PUT,
+    HTTP_PATCH,
+    HTTP_DELETE,
+    HTTP_OPTIONS
+} HTTPMethod;
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
+
+// Overrides the port passed to the constructor when non-zero - port 80 needs root on a PC
+extern int nativeWebServerPort;
+
+class WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    explicit WebServer(int port = 80) : port(port), listenFd(-1), contentLength(CONTENT_LENGTH_NOT_SET) {}
+    ~WebServer() { close(); }
+
+    void begin();
+    void close();
+    void handleClient();
+
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler);
+    void on(const String& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+    void onNotFound(THandlerFunction handler) { notFoundHandler = handler; }
+
+    String uri() { return requestUri; }
+    HTTPMethod method() { return requestMethod; }
+    bool hasArg(const String& name);
+    String arg(const String& name);
+
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void setContentLength(size_t length) { contentLength = length; }
+    void send(int code, const char* contentType = nullptr, const String& content = String(""));
+    void send(int code, const String& contentType, const String& content) { send(code, contentType.c_str(), content); }
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char* content, size_t size);
+
+private:
+    struct Route {
+        String uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+    };
+
+    bool readRequest();
+    void writeAll(const char* data, size_t size);
+
+    int port;
+    int listenFd;
+    WiFiClient client;
+    std::vector<Route> routes;
+    THandlerFunction notFoundHandler;
+
+    String requestUri;
+    HTTPMethod requestMethod = HTTP_ANY;
+    std::vector<std::pair<String, String>> args;  // Query arguments, then the body as "plain"
+    String responseHeaders;
+    size_t contentLength;
+};
+
+#endif // NATIVE_WEBSERVER_H
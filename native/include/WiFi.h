@@ -0,0 +1,50 @@
+#ifndef NATIVE_WIFI_H
+#define NATIVE_WIFI_H
+
+// The host's own network stands in for the station interface: it is always connected,
+// and the dial's address is the loopback one.
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+class WiFiClass {
+public:
+    bool config(IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress());
+    bool mode(wifi_mode_t mode) { (void)mode; return true; }
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr);
+    wl_status_t status() { return WL_CONNECTED; }
+    IPAddress localIP();
+
+    int16_t scanNetworks() { return 0; }
+    String SSID() { return ssid; }
+    String SSID(uint8_t index) { (void)index; return String(); }
+    int32_t RSSI() { return -40; }
+    int32_t RSSI(uint8_t index) { (void)index; return 0; }
+    int32_t channel() { return 1; }
+    int32_t channel(uint8_t index) { (void)index; return 0; }
+    String BSSIDstr() { return "00:00:00:00:00:00"; }
+
+private:
+    String ssid;
+};
+
+extern WiFiClass WiFi;
+
+#endif // NATIVE_WIFI_H
@@ -0,0 +1,44 @@
+#ifndef NATIVE_WIFICLIENT_H
+#define NATIVE_WIFICLIENT_H
+
+// WiFiClient over a POSIX TCP socket, with the ESP32 core's non-blocking read semantics:
+// read() returns -1 straight away when nothing has arrived, and connected() stays true
+// while the peer's data is still buffered.
+
+#include "Arduino.h"
+
+class Client : public Stream {
+public:
+    virtual int connect(IPAddress ip, uint16_t port) = 0;
+    virtual uint8_t connected() = 0;
+    virtual void stop() = 0;
+};
+
+class WiFiClient : public Client {
+public:
+    WiFiClient() : fd(-1) {}
+    ~WiFiClient() { stop(); }
+    WiFiClient(const WiFiClient&) = delete;
+    WiFiClient& operator=(const WiFiClient&) = delete;
+
+    int connect(IPAddress ip, uint16_t port) override { return connect(ip, port, 3000); }
+    int connect(IPAddress ip, uint16_t port, int32_t timeoutMs);
+    uint8_t connected() override;
+    void stop() override;
+    int setNoDelay(bool noDelay);
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int read(uint8_t* buffer, size_t size);
+    int peek() override;
+    operator bool() { return connected(); }
+
+private:
+    friend class WebServer;
+    int fd;
+};
+
+#endif // NATIVE_WIFICLIENT_H
@@ -0,0 +1,8 @@
+#ifndef CREDENTIALS_H
+#define CREDENTIALS_H
+
+// Host builds use the computer's own network; include/credentials.h wins if it exists
+#define WIFI_SSID "native"
+#define WIFI_PASSWORD ""
+
+#endif // CREDENTIALS_H
@@ -0,0 +1,27 @@
+#ifndef NATIVE_FREERTOS_H
+#define NATIVE_FREERTOS_H
+
+// FreeRTOS on POSIX threads - tasks are threads, one tick is a millisecond (as on the
+// ESP32 Arduino core). Priorities and core affinity are accepted and ignored.
+
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t EventBits_t;
+
+typedef struct NativeTask* TaskHandle_t;
+typedef struct NativeQueue* QueueHandle_t;
+typedef struct NativeEventGroup* EventGroupHandle_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskIDLE_PRIORITY ((UBaseType_t)0)
+
+#endif // NATIVE_FREERTOS_H
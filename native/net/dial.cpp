@@ -0,0 +1,30 @@
+// The dial firmware as a host program: setup() once, then loop() for good.
+// The REST API listens on --port (default 8080) and the FreeSleep client talks to
+// real controllers or tools/mock_freesleep.py over the host's network.
+//
+//   .pio/build/native-net/program --port 8080
+//
+// tools/freesleep_scenarios.py --native runs it against the mock and checks the results.
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+void setup();
+void loop();
+
+int main(int argc, char** argv) {
+    nativeWebServerPort = 8080;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--port") && i + 1 < argc) {
+            nativeWebServerPort = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--port N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    setup();
+    for (;;) {
+        loop();
+    }
+}
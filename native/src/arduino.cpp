@@ -0,0 +1,275 @@
+// Arduino core pieces for the host build (native/include/Arduino.h, Preferences.h)
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <malloc.h>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace {
+
+const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+std::mutex serialLock;  // Tasks print too
+
+std::mt19937& randomEngine() {
+    static std::mt19937 engine(std::random_device{}());
+    return engine;
+}
+
+}  // namespace
+
+unsigned long millis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+
+unsigned long micros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+long random(long howbig) {
+    return howbig > 0 ? random(0, howbig) : 0;
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return std::uniform_int_distribution<long>(howsmall, howbig - 1)(randomEngine());
+}
+
+void randomSeed(unsigned long seed) {
+    randomEngine().seed(seed);
+}
+
+size_t nativeStrlcpy(char* dst, const char* src, size_t size) {
+    size_t length = strlen(src);
+    if (size) {
+        size_t copied = min(length, size - 1);
+        memcpy(dst, src, copied);
+        dst[copied] = 0;
+    }
+    return length;
+}
+
+// --- String ---
+
+String::String(float number, unsigned int decimals) : String((double)number, decimals) {}
+
+String::String(double number, unsigned int decimals) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.*f", (int)decimals, number);
+    value = text;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t found = value.find(c, from);
+    return found == std::string::npos ? -1 : (int)found;
+}
+
+int String::indexOf(const char* str, unsigned int from) const {
+    size_t found = value.find(str, from);
+    return found == std::string::npos ? -1 : (int)found;
+}
+
+bool String::endsWith(const String& suffix) const {
+    return value.size() >= suffix.value.size() &&
+           value.compare(value.size() - suffix.value.size(), suffix.value.size(), suffix.value) == 0;
+}
+
+String String::substring(unsigned int left, unsigned int right) const {
+    if (left > right) std::swap(left, right);
+    if (left >= value.size()) return String();
+    return String(value.substr(left, min((size_t)right, value.size()) - left));
+}
+
+void String::trim() {
+    size_t first = value.find_first_not_of(" \t\r\n");
+    size_t last = value.find_last_not_of(" \t\r\n");
+    value = first == std::string::npos ? std::string() : value.substr(first, last - first + 1);
+}
+
+void String::toLowerCase() {
+    for (char& c : value) c = tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+    for (char& c : value) c = toupper((unsigned char)c);
+}
+
+StringSumHelper operator+(const String& lhs, const String& rhs) { StringSumHelper sum(lhs); sum += rhs; return sum; }
+StringSumHelper operator+(const String& lhs, const char* rhs) { StringSumHelper sum(lhs); sum += rhs; return sum; }
+StringSumHelper operator+(const char* lhs, const String& rhs) { StringSumHelper sum(lhs); sum += rhs; return sum; }
+StringSumHelper operator+(const String& lhs, char rhs) { StringSumHelper sum(lhs); sum += rhs; return sum; }
+StringSumHelper operator+(const String& lhs, int rhs) { StringSumHelper sum(lhs); sum += rhs; return sum; }
+StringSumHelper operator+(const String& lhs, unsigned int rhs) { StringSumHelper sum(lhs); sum += rhs; return sum; }
+StringSumHelper operator+(const String& lhs, long rhs) { StringSumHelper sum(lhs); sum += rhs; return sum; }
+StringSumHelper operator+(const String& lhs, unsigned long rhs) { StringSumHelper sum(lhs); sum += rhs; return sum; }
+
+// --- Print / Stream ---
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (size-- && write(*buffer++)) written++;
+    return written;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char small[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (length < 0) return 0;
+    if ((size_t)length < sizeof(small)) return write((const uint8_t*)small, length);
+
+    std::vector<char> large(length + 1);
+    va_start(args, format);
+    vsnprintf(large.data(), large.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)large.data(), length);
+}
+
+size_t Print::print(const struct tm* timeinfo, const char* format) {
+    char text[64];
+    size_t length = strftime(text, sizeof(text), format ? format : "%c", timeinfo);
+    return write((const uint8_t*)text, length);
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    unsigned long start = millis();
+    while (count < length) {
+        int c = read();
+        if (c < 0) {
+            if (millis() - start >= timeoutMs) break;
+            delay(1);
+            continue;
+        }
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    std::lock_guard<std::mutex> guard(serialLock);
+    size_t written = fwrite(buffer, 1, size, stdout);
+    fflush(stdout);
+    return written;
+}
+
+// --- IPAddress ---
+
+IPAddress::IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth) {
+    uint8_t* bytes = (uint8_t*)&address;
+    bytes[0] = first;
+    bytes[1] = second;
+    bytes[2] = third;
+    bytes[3] = fourth;
+}
+
+bool IPAddress::fromString(const char* text) {
+    unsigned int octets[4];
+    char tail;
+    if (sscanf(text, "%u.%u.%u.%u%c", &octets[0], &octets[1], &octets[2], &octets[3], &tail) != 4) return false;
+    for (unsigned int octet : octets) {
+        if (octet > 255) return false;
+    }
+    *this = IPAddress(octets[0], octets[1], octets[2], octets[3]);
+    return true;
+}
+
+String IPAddress::toString() const {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(text);
+}
+
+// --- Time ---
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1, const char* server2, const char* server3) {
+    (void)gmtOffsetSec; (void)daylightOffsetSec; (void)server1; (void)server2; (void)server3;
+}
+
+bool getLocalTime(struct tm* info, uint32_t ms) {
+    (void)ms;
+    time_t now = time(nullptr);
+    return localtime_r(&now, info) != nullptr;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    return (uint32_t)mallinfo2().fordblks;
+}
+
+// --- Preferences ---
+
+namespace {
+
+std::map<std::string, std::vector<uint8_t>>& preferenceStore() {
+    static std::map<std::string, std::vector<uint8_t>> store;
+    return store;
+}
+
+std::mutex preferenceLock;
+
+}  // namespace
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partitionLabel) {
+    (void)readOnly; (void)partitionLabel;
+    this->name = String(name) + "/";
+    return true;
+}
+
+bool Preferences::isKey(const char* key) {
+    std::lock_guard<std::mutex> guard(preferenceLock);
+    return preferenceStore().count(std::string((name + key).c_str())) != 0;
+}
+
+bool Preferences::remove(const char* key) {
+    std::lock_guard<std::mutex> guard(preferenceLock);
+    return preferenceStore().erase(std::string((name + key).c_str())) != 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    std::lock_guard<std::mutex> guard(preferenceLock);
+    const uint8_t* bytes = (const uint8_t*)value;
+    preferenceStore()[std::string((name + key).c_str())].assign(bytes, bytes + length);
+    return length;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+    std::lock_guard<std::mutex> guard(preferenceLock);
+    auto found = preferenceStore().find(std::string((name + key).c_str()));
+    if (found == preferenceStore().end()) return defaultValue;
+    return String((const char*)found->second.data(), found->second.size());
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    std::lock_guard<std::mutex> guard(preferenceLock);
+    auto found = preferenceStore().find(std::string((name + key).c_str()));
+    return found == preferenceStore().end() ? 0 : found->second.size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t length) {
+    std::lock_guard<std::mutex> guard(preferenceLock);
+    auto found = preferenceStore().find(std::string((name + key).c_str()));
+    if (found == preferenceStore().end() || found->second.size() > length) return 0;
+    memcpy(buffer, found->second.data(), found->second.size());
+    return found->second.size();
+}
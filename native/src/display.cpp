@@ -0,0 +1,257 @@
+// Framebuffer drawing for the host build (native/include/M5Dial.h)
+
+#include <M5Dial.h>
+
+namespace fonts {
+// Heights are the real fonts' line advance; widths their average glyph
+const lgfx::IFont Font0 = {"Font0", 8, 6};
+const lgfx::IFont Font2 = {"Font2", 16, 8};
+const lgfx::IFont Font4 = {"Font4", 26, 14};
+const lgfx::IFont Font7 = {"Font7", 48, 32};
+const lgfx::IFont FreeSans9pt7b = {"FreeSans9pt7b", 22, 10};
+const lgfx::IFont FreeSans12pt7b = {"FreeSans12pt7b", 29, 13};
+const lgfx::IFont FreeSansBold9pt7b = {"FreeSansBold9pt7b", 22, 11};
+const lgfx::IFont FreeSansBold12pt7b = {"FreeSansBold12pt7b", 29, 14};
+const lgfx::IFont FreeSansBold18pt7b = {"FreeSansBold18pt7b", 42, 20};
+const lgfx::IFont FreeSansBold24pt7b = {"FreeSansBold24pt7b", 56, 27};
+}  // namespace fonts
+
+m5::M5Unified M5;
+M5_DIAL M5Dial;
+uint64_t nativePixelsDrawn = 0;
+
+namespace {
+
+// 5x8 glyphs for ' '..'~', one byte per column, least significant bit at the top
+const uint8_t GLYPHS[][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x00, 0x60, 0x60, 0x00},
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4D, 0x33}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x00, 0x14, 0x00, 0x00},
+    {0x00, 0x40, 0x34, 0x00, 0x00}, {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06}, {0x3E, 0x41, 0x5D, 0x59, 0x4E},
+    {0x7C, 0x12, 0x11, 0x12, 0x7C}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+    {0x3E, 0x41, 0x41, 0x51, 0x73}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x1C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x26, 0x49, 0x49, 0x49, 0x32}, {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x59, 0x49, 0x4D, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x41},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x41, 0x7F}, {0x04, 0x02, 0x01, 0x02, 0x04},
+    {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x03, 0x07, 0x08, 0x00}, {0x20, 0x54, 0x54, 0x78, 0x40},
+    {0x7F, 0x28, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x28}, {0x38, 0x44, 0x44, 0x28, 0x7F},
+    {0x38, 0x54, 0x54, 0x54, 0x18}, {0x00, 0x08, 0x7E, 0x09, 0x02}, {0x18, 0xA4, 0xA4, 0x9C, 0x78},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x40, 0x3D, 0x00},
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x78, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0xFC, 0x18, 0x24, 0x24, 0x18},
+    {0x18, 0x24, 0x24, 0x18, 0xFC}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x24},
+    {0x04, 0x04, 0x3F, 0x44, 0x24}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x4C, 0x90, 0x90, 0x90, 0x7C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x77, 0x00, 0x00},
+    {0x00, 0x41, 0x36, 0x08, 0x00}, {0x02, 0x01, 0x02, 0x04, 0x02},
+};
+const uint8_t DEGREE_GLYPH[5] = {0x00, 0x06, 0x09, 0x09, 0x06};
+const uint8_t MISSING_GLYPH[5] = {0x7F, 0x41, 0x41, 0x41, 0x7F};
+
+// Next code point of a UTF-8 string, as LovyanGFX decodes it
+uint32_t nextCodePoint(const char*& text) {
+    uint8_t c = *text++;
+    if (c < 0x80) return c;
+    int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+    uint32_t code = c & (0x3F >> extra);
+    while (extra-- && (*text & 0xC0) == 0x80) code = (code << 6) | (*text++ & 0x3F);
+    return code;
+}
+
+const uint8_t* glyphFor(uint32_t code) {
+    if (code >= ' ' && code <= '~') return GLYPHS[code - ' '];
+    if (code == 0xB0) return DEGREE_GLYPH;
+    return MISSING_GLYPH;
+}
+
+int codePointCount(const char* text) {
+    int count = 0;
+    while (*text) {
+        nextCodePoint(text);
+        count++;
+    }
+    return count;
+}
+
+}  // namespace
+
+void LovyanGFX::attach(uint16_t* pixels, int32_t w, int32_t h) {
+    buffer = pixels;
+    frameWidth = pixels ? w : 0;
+    frameHeight = pixels ? h : 0;
+    clearClipRect();
+}
+
+uint16_t LovyanGFX::readPixel(int32_t x, int32_t y) const {
+    if (!buffer || x < 0 || y < 0 || x >= frameWidth || y >= frameHeight) return 0;
+    return buffer[y * frameWidth + x];
+}
+
+void LovyanGFX::setClipRect(int32_t x, int32_t y, int32_t w, int32_t h) {
+    clipLeft = max(x, (int32_t)0);
+    clipTop = max(y, (int32_t)0);
+    clipRight = min(x + w, frameWidth) - 1;
+    clipBottom = min(y + h, frameHeight) - 1;
+}
+
+void LovyanGFX::plot(int32_t x, int32_t y, uint16_t color) {
+    if (!inClip(x, y)) return;
+    buffer[y * frameWidth + x] = color;
+    nativePixelsDrawn++;
+}
+
+void LovyanGFX::fillRectRaw(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    int32_t left = max(x, clipLeft), right = min(x + w - 1, clipRight);
+    int32_t top = max(y, clipTop), bottom = min(y + h - 1, clipBottom);
+    if (left > right) return;
+    for (int32_t row = top; row <= bottom; row++) {
+        std::fill(buffer + row * frameWidth + left, buffer + row * frameWidth + right + 1, color);
+    }
+    if (bottom >= top) nativePixelsDrawn += (uint64_t)(right - left + 1) * (bottom - top + 1);
+}
+
+void LovyanGFX::drawRectRaw(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    fillRectRaw(x, y, w, 1, color);
+    fillRectRaw(x, y + h - 1, w, 1, color);
+    fillRectRaw(x, y + 1, 1, h - 2, color);
+    fillRectRaw(x + w - 1, y + 1, 1, h - 2, color);
+}
+
+void LovyanGFX::fillRoundRectRaw(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) {
+    r = min(r, min(w, h) / 2);
+    for (int32_t row = 0; row < h; row++) {
+        // Inset of this row from the corner arcs
+        int32_t dy = row < r ? r - row : row >= h - r ? row - (h - r - 1) : 0;
+        int32_t inset = dy ? r - (int32_t)sqrtf((float)(r * r - (dy - 0.5f) * (dy - 0.5f))) : 0;
+        fillRectRaw(x + inset, y + row, w - 2 * inset, 1, color);
+    }
+}
+
+void LovyanGFX::fillCircleRaw(int32_t x, int32_t y, int32_t r, uint16_t color) {
+    for (int32_t dy = -r; dy <= r; dy++) {
+        int32_t dx = (int32_t)sqrtf((float)(r * r - dy * dy) + r * 0.5f);
+        fillRectRaw(x - dx, y + dy, 2 * dx + 1, 1, color);
+    }
+}
+
+void LovyanGFX::drawCircleRaw(int32_t x, int32_t y, int32_t r, uint16_t color) {
+    // Midpoint circle, eight octants at a time
+    int32_t dx = r, dy = 0, error = 1 - r;
+    while (dx >= dy) {
+        const int32_t points[8][2] = {{dx, dy}, {dy, dx}, {-dy, dx}, {-dx, dy}, {-dx, -dy}, {-dy, -dx}, {dy, -dx}, {dx, -dy}};
+        for (const auto& point : points) plot(x + point[0], y + point[1], color);
+        dy++;
+        if (error < 0) {
+            error += 2 * dy + 1;
+        } else {
+            dx--;
+            error += 2 * (dy - dx) + 1;
+        }
+    }
+}
+
+void LovyanGFX::drawLineRaw(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color) {
+    int32_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int32_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int32_t error = dx + dy;
+    for (;;) {
+        plot(x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        int32_t twice = 2 * error;
+        if (twice >= dy) { error += dy; x0 += sx; }
+        if (twice <= dx) { error += dx; y0 += sy; }
+    }
+}
+
+void LovyanGFX::fillArcRaw(int32_t x, int32_t y, int32_t r0, int32_t r1, float angle0, float angle1, uint16_t color) {
+    int32_t inner = min(r0, r1), outer = max(r0, r1);
+    float start = fmodf(angle0, 360), sweep = angle1 - angle0;
+    if (start < 0) start += 360;
+    if (sweep <= 0) return;
+    for (int32_t dy = -outer; dy <= outer; dy++) {
+        for (int32_t dx = -outer; dx <= outer; dx++) {
+            int32_t distance = dx * dx + dy * dy;
+            if (distance < inner * inner || distance > outer * outer) continue;
+            float angle = atan2f((float)dy, (float)dx) * 180 / (float)PI - start;
+            if (angle < 0) angle += 360;
+            if (sweep >= 360 || angle <= sweep) plot(x + dx, y + dy, color);
+        }
+    }
+}
+
+int32_t LovyanGFX::fontHeight() const {
+    return (int32_t)(textFont->height * textSize);
+}
+
+int32_t LovyanGFX::textWidth(const char* text) const {
+    return (int32_t)(codePointCount(text) * textFont->advance * textSize);
+}
+
+int32_t LovyanGFX::drawString(const char* text, int32_t x, int32_t y) {
+    int32_t width = textWidth(text);
+    int32_t height = fontHeight();
+    int horizontal = textDatum & 3, vertical = textDatum & 12;
+    if (horizontal == 1) x -= width / 2;
+    if (horizontal == 2) x -= width;
+    if (textDatum & 16) y -= height * 3 / 4;  // Baseline
+    else if (vertical == 4) y -= height / 2;
+    else if (vertical == 8) y -= height;
+
+    if (textFillBackground) fillRectRaw(x, y, width, height, textBackground);
+
+    // Each glyph's 6x8 cell (5 columns and a space) is stretched over the font's advance and height
+    float cellWidth = textFont->advance * textSize / 6, cellHeight = height / 8.0f;
+    float left = (float)x;
+    while (*text) {
+        const uint8_t* glyph = glyphFor(nextCodePoint(text));
+        for (int column = 0; column < 5; column++) {
+            int32_t x0 = (int32_t)(left + column * cellWidth), x1 = (int32_t)(left + (column + 1) * cellWidth);
+            for (int row = 0; row < 8; row++) {
+                if (!(glyph[column] & (1 << row))) continue;
+                int32_t y0 = y + (int32_t)(row * cellHeight), y1 = y + (int32_t)((row + 1) * cellHeight);
+                fillRectRaw(x0, y0, max(x1 - x0, (int32_t)1), max(y1 - y0, (int32_t)1), textColor);
+            }
+        }
+        left += 6 * cellWidth;
+    }
+    return width;
+}
+
+M5GFX::M5GFX() {
+    memset(panel, 0, sizeof(panel));
+    attach(panel, 240, 240);
+}
+
+void* LGFX_Sprite::createSprite(int32_t w, int32_t h) {
+    deleteSprite();
+    if (w > 0 && h > 0) attach((uint16_t*)calloc(w * h, sizeof(uint16_t)), w, h);
+    return buffer;
+}
+
+void LGFX_Sprite::deleteSprite() {
+    free(buffer);
+    attach(nullptr, 0, 0);
+}
+
+void LGFX_Sprite::copyTo(LovyanGFX* dst, int32_t x, int32_t y, bool useTransparent, uint16_t transparent) const {
+    if (!buffer || !dst->buffer) return;
+    for (int32_t row = 0; row < frameHeight; row++) {
+        for (int32_t column = 0; column < frameWidth; column++) {
+            uint16_t color = buffer[row * frameWidth + column];
+            if (useTransparent && color == transparent) continue;
+            if (dst->inClip(x + column, y + row)) dst->buffer[(y + row) * dst->frameWidth + x + column] = color;
+        }
+    }
+}
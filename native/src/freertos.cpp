@@ -0,0 +1,166 @@
+// FreeRTOS tasks, queues, notifications and event groups on std::thread
+// (native/include/freertos/)
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/event_groups.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct NativeTask {
+    std::mutex lock;
+    std::condition_variable changed;
+    uint32_t notifications = 0;
+};
+
+struct NativeQueue {
+    std::mutex lock;
+    std::condition_variable changed;
+    std::vector<uint8_t> items;  // Ring of length * itemSize bytes
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t head = 0;
+    UBaseType_t count = 0;
+};
+
+struct NativeEventGroup {
+    std::mutex lock;
+    std::condition_variable changed;
+    EventBits_t bits = 0;
+};
+
+namespace {
+
+// The thread that calls setup() and loop() is a task too. The allocation counter asks
+// which task is running from inside malloc, so this is a plain global, not a lazy static.
+NativeTask mainTask;
+thread_local NativeTask* currentTask = nullptr;
+
+// Wait on `changed` until ready() or the ticks run out; portMAX_DELAY waits for good
+template <typename Ready>
+bool waitTicks(std::condition_variable& changed, std::unique_lock<std::mutex>& guard, TickType_t ticks, Ready ready) {
+    if (ticks == portMAX_DELAY) {
+        changed.wait(guard, ready);
+        return true;
+    }
+    return changed.wait_for(guard, std::chrono::milliseconds(ticks), ready);
+}
+
+}  // namespace
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char* name, uint32_t stackDepth, void* parameters,
+                                   UBaseType_t priority, TaskHandle_t* createdTask, BaseType_t coreId) {
+    (void)name; (void)stackDepth; (void)priority; (void)coreId;
+    NativeTask* task = new NativeTask();
+    if (createdTask) *createdTask = task;
+    std::thread([task, code, parameters]() {
+        currentTask = task;
+        code(parameters);
+    }).detach();
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return currentTask ? currentTask : &mainTask;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    delay(ticks);
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)millis();
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    std::lock_guard<std::mutex> guard(task->lock);
+    task->notifications++;
+    task->changed.notify_all();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait) {
+    NativeTask* task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> guard(task->lock);
+    waitTicks(task->changed, guard, ticksToWait, [task]() { return task->notifications > 0; });
+    uint32_t value = task->notifications;
+    if (value) task->notifications = clearCountOnExit ? 0 : value - 1;
+    return value;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    NativeQueue* queue = new NativeQueue();
+    queue->items.resize(length * itemSize);
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> guard(queue->lock);
+    if (!waitTicks(queue->changed, guard, ticksToWait, [queue]() { return queue->count < queue->length; })) {
+        return pdFALSE;
+    }
+    UBaseType_t tail = (queue->head + queue->count) % queue->length;
+    memcpy(&queue->items[tail * queue->itemSize], item, queue->itemSize);
+    queue->count++;
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* buffer, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> guard(queue->lock);
+    if (!waitTicks(queue->changed, guard, ticksToWait, [queue]() { return queue->count > 0; })) {
+        return pdFALSE;
+    }
+    memcpy(buffer, &queue->items[queue->head * queue->itemSize], queue->itemSize);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> guard(queue->lock);
+    return queue->count;
+}
+
+EventGroupHandle_t xEventGroupCreate() {
+    return new NativeEventGroup();
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits) {
+    std::lock_guard<std::mutex> guard(group->lock);
+    group->bits |= bits;
+    group->changed.notify_all();
+    return group->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits) {
+    std::lock_guard<std::mutex> guard(group->lock);
+    EventBits_t before = group->bits;
+    group->bits &= ~bits;
+    return before;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group) {
+    std::lock_guard<std::mutex> guard(group->lock);
+    return group->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit,
+                                BaseType_t waitForAllBits, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> guard(group->lock);
+    auto satisfied = [group, bits, waitForAllBits]() {
+        return waitForAllBits ? (group->bits & bits) == bits : (group->bits & bits) != 0;
+    };
+    bool met = waitTicks(group->changed, guard, ticksToWait, satisfied);
+    EventBits_t value = group->bits;
+    if (met && clearOnExit) group->bits &= ~bits;
+    return value;
+}
@@ -0,0 +1,336 @@
+// WiFi, TCP client, web server and mDNS for the host build
+// (native/include/WiFi.h, WiFiClient.h, WebServer.h, ESPmDNS.h)
+
+#include <WiFi.h>
+#include <WiFiClient.h>
+#include <WebServer.h>
+#include <ESPmDNS.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+MDNSResponder MDNS;
+int nativeWebServerPort = 0;
+
+namespace {
+
+bool waitFd(int fd, short events, int timeoutMs) {
+    pollfd entry = {fd, events, 0};
+    return poll(&entry, 1, timeoutMs) == 1 && (entry.revents & events);
+}
+
+}  // namespace
+
+// --- WiFi ---
+
+bool WiFiClass::config(IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1) {
+    (void)localIP; (void)gateway; (void)subnet; (void)dns1;
+    return true;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase) {
+    (void)passphrase;
+    this->ssid = ssid;
+    return WL_CONNECTED;
+}
+
+IPAddress WiFiClass::localIP() {
+    return IPAddress(127, 0, 0, 1);
+}
+
+// --- WiFiClient ---
+
+int WiFiClient::connect(IPAddress ip, uint16_t port, int32_t timeoutMs) {
+    stop();
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return 0;
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = (uint32_t)ip;
+
+    // Non-blocking connect bounded by the timeout, then back to blocking writes
+    int flags = fcntl(fd, F_GETFL);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    int result = ::connect(fd, (sockaddr*)&address, sizeof(address));
+    if (result < 0 && errno == EINPROGRESS && waitFd(fd, POLLOUT, timeoutMs)) {
+        int error = 0;
+        socklen_t length = sizeof(error);
+        getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+        result = error ? -1 : 0;
+    }
+    if (result < 0) {
+        stop();
+        return 0;
+    }
+    fcntl(fd, F_SETFL, flags);
+
+    timeval sendTimeout = {5, 0};  // The ESP32 core gives up on a write after a few seconds too
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &sendTimeout, sizeof(sendTimeout));
+    return 1;
+}
+
+uint8_t WiFiClient::connected() {
+    if (fd < 0) return 0;
+    char c;
+    ssize_t result = recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (result > 0 || (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))) return 1;
+    // Closed by the peer with nothing left to read, or reset
+    stop();
+    return 0;
+}
+
+void WiFiClient::stop() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+}
+
+int WiFiClient::setNoDelay(bool noDelay) {
+    int value = noDelay ? 1 : 0;
+    return fd >= 0 ? setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value)) : -1;
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (fd >= 0 && written < size) {
+        ssize_t result = send(fd, buffer + written, size - written, MSG_NOSIGNAL);
+        if (result <= 0) {
+            if (result < 0 && errno == EINTR) continue;
+            stop();
+            break;
+        }
+        written += result;
+    }
+    return written;
+}
+
+int WiFiClient::available() {
+    int count = 0;
+    if (fd < 0 || ioctl(fd, FIONREAD, &count) < 0) return 0;
+    return count;
+}
+
+int WiFiClient::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+    if (fd < 0) return -1;
+    ssize_t result = recv(fd, buffer, size, MSG_DONTWAIT);
+    return result > 0 ? (int)result : -1;  // End of stream and errors show through connected()
+}
+
+int WiFiClient::peek() {
+    uint8_t c;
+    return fd >= 0 && recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? c : -1;
+}
+
+// --- WebServer ---
+
+namespace {
+
+const int REQUEST_TIMEOUT_MS = 2000;
+const size_t REQUEST_MAX_BYTES = 16384;
+
+const char* reasonPhrase(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 202: return "Accepted";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 409: return "Conflict";
+        case 503: return "Service Unavailable";
+        default: return "";
+    }
+}
+
+HTTPMethod parseMethod(const String& name) {
+    if (name == "GET") return HTTP_GET;
+    if (name == "HEAD") return HTTP_HEAD;
+    if (name == "POST") return HTTP_POST;
+    if (name == "PUT") return HTTP_PUT;
+    if (name == "PATCH") return HTTP_PATCH;
+    if (name == "DELETE") return HTTP_DELETE;
+    if (name == "OPTIONS") return HTTP_OPTIONS;
+    return HTTP_ANY;
+}
+
+String urlDecode(const String& text) {
+    String decoded;
+    for (unsigned int i = 0; i < text.length(); i++) {
+        char c = text[i];
+        if (c == '+') {
+            decoded += ' ';
+        } else if (c == '%' && i + 2 < text.length()) {
+            char hex[3] = {text[i + 1], text[i + 2], 0};
+            decoded += (char)strtol(hex, nullptr, 16);
+            i += 2;
+        } else {
+            decoded += c;
+        }
+    }
+    return decoded;
+}
+
+}  // namespace
+
+void WebServer::begin() {
+    int listenPort = nativeWebServerPort ? nativeWebServerPort : port;
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(listenPort);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(listenFd, (sockaddr*)&address, sizeof(address)) < 0 || listen(listenFd, 16) < 0) {
+        // Nothing useful runs without the REST API, and a stale dial would answer in its place
+        Serial.printf("WebServer: can't listen on port %d: %s\n", listenPort, strerror(errno));
+        exit(1);
+    }
+    fcntl(listenFd, F_SETFL, fcntl(listenFd, F_GETFL) | O_NONBLOCK);
+}
+
+void WebServer::close() {
+    client.stop();
+    if (listenFd >= 0) ::close(listenFd);
+    listenFd = -1;
+}
+
+void WebServer::on(const String& uri, HTTPMethod method, THandlerFunction handler) {
+    routes.push_back({uri, method, handler});
+}
+
+void WebServer::handleClient() {
+    if (listenFd < 0) return;
+    int fd = accept(listenFd, nullptr, nullptr);
+    if (fd < 0) return;
+
+    client.stop();
+    client.fd = fd;
+    args.clear();
+    responseHeaders = "";
+    contentLength = CONTENT_LENGTH_NOT_SET;
+
+    if (readRequest()) {
+        const Route* match = nullptr;
+        for (const Route& route : routes) {
+            if (route.uri == requestUri && (route.method == HTTP_ANY || route.method == requestMethod)) {
+                match = &route;
+                break;
+            }
+        }
+        if (match) {
+            match->handler();
+        } else if (notFoundHandler) {
+            notFoundHandler();
+        } else {
+            send(404, "text/plain", "Not found");
+        }
+    }
+    client.stop();
+}
+
+// Request line, headers and body, within one timeout like the ESP32 server's
+bool WebServer::readRequest() {
+    std::string data;
+    unsigned long deadline = millis() + REQUEST_TIMEOUT_MS;
+    size_t headerEnd = std::string::npos;
+    size_t bodyLength = 0;
+    for (;;) {
+        if (headerEnd == std::string::npos) {
+            headerEnd = data.find("\r\n\r\n");
+            if (headerEnd != std::string::npos) {
+                std::string head = data.substr(0, headerEnd);
+                for (char& c : head) c = tolower((unsigned char)c);
+                size_t field = head.find("\r\ncontent-length:");
+                if (field != std::string::npos) bodyLength = strtoul(head.c_str() + field + 17, nullptr, 10);
+            }
+        }
+        if (headerEnd != std::string::npos && data.size() >= headerEnd + 4 + bodyLength) break;
+
+        long remaining = (long)(deadline - millis());
+        if (remaining <= 0 || data.size() > REQUEST_MAX_BYTES || !waitFd(client.fd, POLLIN, remaining)) return false;
+        char chunk[1024];
+        ssize_t received = recv(client.fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) return false;
+        data.append(chunk, received);
+    }
+
+    size_t lineEnd = data.find("\r\n");
+    std::string line = data.substr(0, lineEnd);
+    size_t methodEnd = line.find(' ');
+    size_t targetEnd = line.find(' ', methodEnd + 1);
+    if (methodEnd == std::string::npos || targetEnd == std::string::npos) return false;
+    requestMethod = parseMethod(String(line.substr(0, methodEnd)));
+    std::string target = line.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+
+    size_t query = target.find('?');
+    requestUri = String(target.substr(0, query));
+    if (query != std::string::npos) {
+        String pairs(target.substr(query + 1));
+        int start = 0;
+        while (start <= (int)pairs.length()) {
+            int end = pairs.indexOf('&', start);
+            if (end < 0) end = pairs.length();
+            String pair = pairs.substring(start, end);
+            int equals = pair.indexOf('=');
+            if (pair.length()) {
+                args.push_back({urlDecode(equals < 0 ? pair : pair.substring(0, equals)),
+                                urlDecode(equals < 0 ? String() : pair.substring(equals + 1))});
+            }
+            start = end + 1;
+        }
+    }
+    if (bodyLength) args.push_back({"plain", String(data.substr(headerEnd + 4, bodyLength))});
+    return true;
+}
+
+bool WebServer::hasArg(const String& name) {
+    for (const auto& entry : args) {
+        if (entry.first == name) return true;
+    }
+    return false;
+}
+
+String WebServer::arg(const String& name) {
+    for (const auto& entry : args) {
+        if (entry.first == name) return entry.second;
+    }
+    return String();
+}
+
+void WebServer::sendHeader(const String& name, const String& value, bool first) {
+    String header = name + ": " + value + "\r\n";
+    responseHeaders = first ? header + responseHeaders : responseHeaders + header;
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+    size_t length = contentLength == CONTENT_LENGTH_NOT_SET ? content.length() : contentLength;
+    String head = String("HTTP/1.1 ") + code + " " + reasonPhrase(code) + "\r\n";
+    if (contentType && *contentType) head += String("Content-Type: ") + contentType + "\r\n";
+    if (length != CONTENT_LENGTH_UNKNOWN) head += String("Content-Length: ") + (unsigned long)length + "\r\n";
+    head += responseHeaders;
+    head += "Connection: close\r\n\r\n";
+    writeAll(head.c_str(), head.length());
+    writeAll(content.c_str(), content.length());
+}
+
+void WebServer::sendContent(const char* content, size_t size) {
+    writeAll(content, size);
+}
+
+void WebServer::writeAll(const char* data, size_t size) {
+    client.write((const uint8_t*)data, size);
+}
@@ -6,20 +6,26 @@
 #include <Preferences.h>
 #include <time.h>
 #include <WiFiClient.h>
+#include <ESPmDNS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/event_groups.h>
 #include "config.h"
+#include "theme.h"
+#include "render_profile.h"
 
 Preferences preferences;
 
 // Global variables
-float bedSetpoint = TEMP_DEFAULT;
-float pillowSetpoint = TEMP_DEFAULT;
 bool wifiConnected = false;
 long lastEncoderPosition = 0;
 unsigned long lastActivityTime = 0;
 unsigned long lastClockUpdate = 0;
 bool isDimmed = false;
+bool ambientFaceActive = false;  // Dimmed clock face showing only time and setpoint
+long ambientLastMinute = -1;     // Minute currently shown on the ambient face
 bool timeInitialized = false;
-bool pillowModeActive = false;  // false = bed mode (default), true = pillow mode
 bool nightModeOverride = false;  // Manual night mode override
 bool inSettingsMenu = false;     // Whether settings menu is active
 
@@ -33,26 +39,60 @@ bool bedSideRight = false;  // Default to left side
 // Temperature unit setting (true = Fahrenheit, false = Celsius)
 bool useFahrenheit = false;  // Default to Celsius
 
-// FreeSleep power state (true = on, false = off)
-bool bedPowerOn = true;      // Assume on until we fetch status
-bool pillowPowerOn = true;   // Assume on until we fetch status
-
-// Debounce for FreeSleep API updates
+// Debounce for FreeSleep API updates - the wait after the last change adapts to how the
+// dial is being turned and how fast the pod answers writes. A single detent waits what's
+// left of the 500ms budget once the write's own round trip is counted, so it lands on the
+// pod no later than it used to. Steady stepping waits a little longer than the user's own
+// rhythm, a spin waits the full budget, and a pod slower than that sets the pace itself.
 unsigned long lastSetpointChangeTime = 0;
 bool pendingFreeSleepUpdate = false;
-const unsigned long FREESLEEP_DEBOUNCE_MS = 500;  // Wait 500ms after last change before sending
-const unsigned long SYNC_COOLDOWN_AFTER_CHANGE_MS = 1000;  // Don't sync from pod for 1s after user changes
-
-// Periodic sync from FreeSleep API with exponential backoff
+const unsigned long FREESLEEP_DEBOUNCE_MS = 500;      // Budget from the last change to the pod having it
+const unsigned long FREESLEEP_DEBOUNCE_MIN_MS = 200;  // Shortest wait, however fast the pod
+const unsigned long FREESLEEP_DEBOUNCE_MAX_MS = 800;  // Longest wait, however slow the pod
+const unsigned long FREESLEEP_SPIN_GAP_MS = 100;      // Changes closer than this are a spin
+int setpointBurstChanges = 0;          // Changes in the current burst (each within the max window of the last)
+unsigned long setpointChangeGapMs = 0; // Smoothed time between changes in this burst
+unsigned long writeLatencyMs = 0;      // Smoothed time from sending a write to its result
+
+// Periodic sync from FreeSleep API (failing controllers back off individually - see circuit breakers)
+// The interval follows what the dial is doing: fast while someone is using it, slow when idle,
+// slower still when dimmed at night. Never faster than a few times the observed latency.
 unsigned long lastFreeSleepSync = 0;
-const unsigned long FREESLEEP_SYNC_INTERVAL_MS = 2000;  // Sync every 2 seconds when successful
-unsigned long currentSyncInterval = FREESLEEP_SYNC_INTERVAL_MS;
-const unsigned long MAX_SYNC_INTERVAL_MS = 60000;  // Max backoff of 60 seconds
-int consecutiveFailures = 0;
-bool skipUserUpdates = false;  // Skip user-initiated updates when failing
-
-// Track night mode state to detect changes
-bool wasNightMode = false;
+const unsigned long FREESLEEP_SYNC_INTERVAL_MS = 2000;     // In use, or just used
+const unsigned long FREESLEEP_IDLE_SYNC_MS = 5000;         // Screen on, nobody touching it
+const unsigned long FREESLEEP_DIMMED_SYNC_MS = 15000;      // Screen dimmed
+const unsigned long FREESLEEP_NIGHT_SYNC_MS = 30000;       // Dimmed during night hours
+const unsigned long FREESLEEP_ACTIVE_WINDOW_MS = 30000;    // "In use" for this long after the last input
+const unsigned long FREESLEEP_LATENCY_FACTOR = 4;          // Keep a pod busy at most 1/4 of the time
+const int FREESLEEP_SYNC_JITTER_PCT = 10;                  // +/- so several dials don't poll in lockstep
+bool syncInFlight = false;     // A refresh is queued or running on the FreeSleep task
+unsigned long syncLatencyMs = 0;  // Smoothed refresh duration reported by the task
+uint32_t refreshAllocations = 0;  // Heap allocations the last refresh made
+uint32_t refreshesAllocating = 0; // Refreshes that made any
+int syncJitterPct = 0;            // Re-rolled after every sync
+
+// Ambient face layout and pacing
+const int AMBIENT_TIME_Y = SCREEN_HEIGHT / 2 - 20;
+const int AMBIENT_SETPOINT_Y = SCREEN_HEIGHT / 2 + 45;
+const unsigned long AMBIENT_LOOP_DELAY_MS = 50;  // Slower main loop while ambient; input still polled
+
+// Track the active theme (day/evening/night) to detect changes
+ThemeId lastThemeId = THEME_DAY;
+int themeOverride = -1;  // Forces a ThemeId for render benchmarks (-1 = automatic)
+
+// Render profiling (include/render_profile.h)
+RenderStats renderStats[RENDER_SCREEN_COUNT];
+RenderBench renderBench;
+RenderBenchState renderBenchState = RENDER_BENCH_IDLE;
+bool renderDirtyTracking = false;
+
+// Dirty-region tracking - a hash per 16x16 tile of the last frame pushed. A tile whose hash
+// changed counts as dirty, so dirtyPixels is what a tile-based partial push would have sent.
+// Only kept while a benchmark runs or renderDirtyTracking is on - it's a pass over every frame.
+const int RENDER_TILE = 16;
+const int RENDER_TILE_COLUMNS = (SCREEN_WIDTH + RENDER_TILE - 1) / RENDER_TILE;
+const int RENDER_TILE_ROWS = (SCREEN_HEIGHT + RENDER_TILE - 1) / RENDER_TILE;
+uint32_t frameTileHashes[RENDER_TILE_ROWS][RENDER_TILE_COLUMNS];
 
 // Touch duration tracking for center tap
 unsigned long centerTouchStartTime = 0;
@@ -68,11 +108,45 @@ const unsigned long POWER_MAX_MS = 1000;
 const unsigned long NIGHT_MODE_MAX_MS = 3000;
 const unsigned long TAP_DEBOUNCE_MS = 500;  // Minimum time between taps
 
+// Press-progress ring drawn around the temperature while the center is held
+// A full turn is NIGHT_MODE_MAX_MS; the color changes as each threshold is crossed
+const unsigned long PRESS_RING_FRAME_MS = 33;   // ~30 fps partial updates
+const unsigned long PRESS_RING_DELAY_MS = 100;  // Don't flash the ring on quick taps
+const int PRESS_RING_RADIUS = 70;
+const int PRESS_RING_THICKNESS = 4;
+int pressRingDrawnAngle = 0;        // Degrees of ring currently on screen (0 = none)
+uint16_t pressRingColor = 0;
+unsigned long lastPressRingFrame = 0;
+
+// Zones - one setpoint per pod the dial drives, on the configured side of its controller.
+// Zones 0 and 1 are the original bed and pillow (their names, REST routes and NVS keys are
+// unchanged); more can be added up to MAX_ZONES over /api/zones.
+typedef uint8_t FreeSleepZone;
+const FreeSleepZone ZONE_BED = 0;
+const FreeSleepZone ZONE_PILLOW = 1;
+const int ZONE_NAME_LEN = 16;
+
+// Zone sets travel as uint8_t masks (write batches) and one event-group bit per connection slot
+static_assert(MAX_ZONES >= 1 && MAX_ZONES <= 8, "MAX_ZONES must be 1-8: zone masks are 8 bits wide");
+
+struct Zone {
+    char name[ZONE_NAME_LEN];
+    IPAddress ip;            // 0.0.0.0 = not configured, never polled
+    String controllerName;   // mDNS identity the zone is bound to ("" = not bound yet)
+    float setpoint;
+    bool powerOn;            // Assume on until we fetch status
+};
+
+Zone zones[MAX_ZONES];
+int zoneCount = 2;
+FreeSleepZone activeZone = ZONE_BED;  // Zone the dial is adjusting
+FreeSleepZone pendingFreeSleepZone = ZONE_BED;  // Zone a debounced setpoint was turned on
+FreeSleepZone lastOtherZone = ZONE_PILLOW;  // Zone the left button returns to
+
 // Menu navigation
 enum MenuItem {
     MENU_WIFI_SETTINGS = 0,
-    MENU_BED_IP,
-    MENU_PILLOW_IP,
+    MENU_ZONE_IP,  // One row per zone (see menuRowItem)
     MENU_BED_SIDE,
     MENU_TEMP_UNIT,
     MENU_NIGHT_MODE,
@@ -87,14 +161,14 @@ enum SubMenu {
     SUBMENU_IP_EDITOR
 };
 
-MenuItem currentMenuItem = MENU_WIFI_SETTINGS;
+int currentMenuRow = 0;  // Carousel position; rows map to items via menuRowItem()
 SubMenu currentSubMenu = SUBMENU_NONE;
 int menuScrollOffset = 0;  // Smooth scrolling offset
 
 // IP editor state
 int ipEditorOctet = 0;  // Which octet (0-3) is being edited
 int ipEditorDigit = 0;  // Which digit (0-2) within octet
-bool editingBedIP = false;
+FreeSleepZone editingZone = ZONE_BED;
 uint8_t tempIPOctets[4] = {192, 168, 1, 1};  // Temporary IP being edited
 
 // WiFi scanning
@@ -105,9 +179,439 @@ String wifiPasswordInput = "";
 int passwordCharIndex = 0;  // Current character being edited
 const char alphaNumeric[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz!@#$%^&*()_+-=[]{}|;:',.<>?/ ";
 
-// Target IP addresses for bed and pillow controllers
-IPAddress bedTargetIP(192, 168, 1, 44);     // Default bed controller IP
-IPAddress pillowTargetIP(192, 168, 1, 14);  // Default pillow controller IP
+// Keep-alive connection pool for the FreeSleep controllers
+// One persistent socket per controller IP (zones on the same pod share one),
+// reused for every GET and POST instead of a TCP handshake per request
+const uint16_t FREESLEEP_PORT = 3000;
+const int FREESLEEP_MAX_CONNECTIONS = MAX_ZONES;
+const uint16_t FREESLEEP_TIMEOUT_MS = 2000;    // Whole-cycle budget: connect, request and response
+const uint16_t FREESLEEP_DEADLINE_GRACE_MS = 250;  // Lets a worker finish its last bytes past the deadline
+const char* const FREESLEEP_STATUS_PATH = "/api/deviceStatus";
+
+// Requests are formatted into fixed buffers and written to the socket by hand, and responses
+// are read straight off it, so steady-state polling and writes never touch the heap. The one
+// exception is the socket itself: WiFiClient allocates on connect, which kept-alive
+// connections and event streams only do after the pod drops them. malloc, calloc and realloc
+// are wrapped at link time (platformio.ini) to count the calls made on the FreeSleep task and
+// its workers; each refresh reports its count on /api/debug/sync-stats.
+volatile uint32_t freeSleepAllocations = 0;
+const size_t FREESLEEP_PAYLOAD_MAX = 128;  // Both sides with both fields is ~90 bytes
+const size_t FREESLEEP_REQUEST_MAX = 320;  // Request line, headers and payload
+const size_t FREESLEEP_LINE_MAX = 96;      // Longer response header lines are truncated
+
+// Request telemetry per controller and operation - fixed-bucket latency histograms for the
+// TCP connect (fresh sockets only) and the whole request, plus counts by HTTP status class
+// and error class. Exposed on /api/debug/freesleep-stats.
+enum FreeSleepOperation {
+    FS_OP_STATUS = 0,        // GET deviceStatus
+    FS_OP_WRITE_TEMPERATURE, // POST with only targetTemperatureF
+    FS_OP_WRITE_POWER,       // POST with only isOn
+    FS_OP_WRITE_COMBINED,    // POST with both
+    FS_OP_COUNT
+};
+
+const char* const FS_OP_NAMES[FS_OP_COUNT] = {"status", "writeTemperature", "writePower", "writeCombined"};
+
+enum FreeSleepResultClass {
+    FS_RESULT_2XX = 0,
+    FS_RESULT_3XX,
+    FS_RESULT_4XX,
+    FS_RESULT_5XX,
+    FS_RESULT_CONNECT,   // Refused / unreachable
+    FS_RESULT_SEND,      // Failed writing the request
+    FS_RESULT_LOST,      // Connection dropped or no HTTP response
+    FS_RESULT_TIMEOUT,   // Pod accepted but didn't answer in time
+    FS_RESULT_OTHER,
+    FS_RESULT_COUNT
+};
+
+const char* const FS_RESULT_NAMES[FS_RESULT_COUNT] = {
+    "2xx", "3xx", "4xx", "5xx", "connect", "send", "lost", "timeout", "other"
+};
+
+// Bucket upper bounds in ms; the last bucket collects everything slower
+const uint16_t LATENCY_BUCKET_MS[] = {10, 25, 50, 100, 250, 500, 1000, 2000};
+const int LATENCY_BUCKET_COUNT = sizeof(LATENCY_BUCKET_MS) / sizeof(LATENCY_BUCKET_MS[0]) + 1;
+
+struct LatencyHistogram {
+    uint32_t buckets[LATENCY_BUCKET_COUNT];
+    uint32_t count;
+    uint64_t totalMicros;
+    uint32_t maxMicros;
+};
+
+struct FreeSleepOpStats {
+    LatencyHistogram connect;
+    LatencyHistogram total;
+    uint32_t results[FS_RESULT_COUNT];
+};
+
+volatile bool freeSleepStatsResetRequested = false;  // Set by the web server, honoured by the task
+
+// Circuit breaker per controller - a dead pod backs off on its own without slowing the other.
+// Closed: requests flow. Open: polls and stream attempts are skipped until the probe time.
+// Half-open: the next request is a probe; success closes the breaker, failure reopens it
+// with a longer (jittered) backoff. A user write always goes out as a probe.
+enum BreakerState {
+    BREAKER_CLOSED,
+    BREAKER_OPEN,
+    BREAKER_HALF_OPEN
+};
+
+const char* const BREAKER_STATE_NAMES[] = {"closed", "open", "halfOpen"};
+const uint8_t FREESLEEP_BREAKER_THRESHOLD = 3;           // Consecutive failures before opening
+const unsigned long FREESLEEP_BREAKER_MIN_MS = 4000;     // First open period
+const unsigned long FREESLEEP_BREAKER_MAX_MS = 60000;    // Max backoff of 60 seconds
+
+// Controller workers - every connection slot has its own task, so requests to different
+// controllers run side by side and a refresh or write flush takes as long as the slowest
+// controller rather than the sum of them. The FreeSleep task hands out jobs and waits for all of them.
+enum FreeSleepJobType {
+    FS_JOB_STATUS,  // GET deviceStatus into job.doc
+    FS_JOB_WRITE,   // POST job.batch
+    FS_JOB_PROBE    // Timed diagnostic GET into job.probe
+};
+
+struct FreeSleepWriteBatch;
+
+// Phase timings of one diagnostic request (all in microseconds; 0 = phase not reached)
+struct FreeSleepProbe {
+    int httpCode;
+    uint32_t dnsMicros;        // mDNS lookup of the controller's identity, if it has one
+    uint32_t resolvedIP;
+    uint32_t connectMicros;
+    uint32_t sendMicros;
+    uint32_t firstByteMicros;  // Request sent -> first response byte
+    uint32_t totalMicros;
+    uint32_t bodyBytes;
+};
+
+struct FreeSleepJob {
+    FreeSleepJobType type;
+    const JsonDocument* filter;
+    JsonDocument* doc;  // Worker's arena-backed document, valid once the job has run
+    const FreeSleepWriteBatch* batch;
+    char* host;              // Probe: mDNS identity to resolve first ("" = none)
+    FreeSleepProbe probe;
+    unsigned long deadline;  // Shared by every job of the cycle
+    bool success;
+};
+
+const uint32_t FREESLEEP_WORKER_STACK = 6144;
+
+// Fixed bump allocator for a worker's parsed status. The document is cleared and the arena
+// rewound before every parse, so nothing is ever freed piecemeal. Each block carries its
+// size in front so the parser's string buffers can grow (in place when last).
+const size_t FREESLEEP_ARENA_SIZE = 3072;
+const size_t FREESLEEP_ARENA_ALIGN = 8;
+
+struct FreeSleepArena : ArduinoJson::Allocator {
+    alignas(FREESLEEP_ARENA_ALIGN) uint8_t buffer[FREESLEEP_ARENA_SIZE];
+    size_t used;
+    uint8_t* last;  // Most recent block, the only one that can grow in place
+
+    static size_t round(size_t size) { return (size + FREESLEEP_ARENA_ALIGN - 1) & ~(FREESLEEP_ARENA_ALIGN - 1); }
+    static uint32_t& blockSize(void* ptr) { return *(uint32_t*)((uint8_t*)ptr - FREESLEEP_ARENA_ALIGN); }
+
+    void reset() {
+        used = 0;
+        last = nullptr;
+    }
+
+    void* allocate(size_t size) override {
+        size = round(size);
+        if (size + FREESLEEP_ARENA_ALIGN > FREESLEEP_ARENA_SIZE - used) return nullptr;  // Parser reports NoMemory
+        last = buffer + used + FREESLEEP_ARENA_ALIGN;
+        blockSize(last) = size;
+        used += size + FREESLEEP_ARENA_ALIGN;
+        return last;
+    }
+
+    void deallocate(void*) override {}  // Reclaimed all at once by reset()
+
+    void* reallocate(void* ptr, size_t size) override {
+        if (!ptr) return allocate(size);
+        size = round(size);
+        if (ptr == last) {
+            size_t start = last - buffer;
+            if (size > FREESLEEP_ARENA_SIZE - start) return nullptr;
+            blockSize(ptr) = size;
+            used = start + size;
+            return ptr;
+        }
+        if (size <= blockSize(ptr)) return ptr;
+        void* moved = allocate(size);
+        if (moved) memcpy(moved, ptr, blockSize(ptr));
+        return moved;
+    }
+};
+
+struct FreeSleepConnection {
+    bool assigned;
+    IPAddress ip;
+    char host[24];          // <ip>:3000 for the Host header, formatted when the slot is assigned
+    WiFiClient client;      // Owns the socket, reused across requests
+    long bodyRemaining;     // Response body bytes left (of the current chunk if chunked; -1 = until close)
+    bool bodyChunked;
+    bool bodyStarted;       // Chunked: a chunk has been read, so a CRLF comes before the next size line
+    bool bodyDone;
+    bool keepAlive;         // Socket can carry the next request once the body is drained
+    unsigned long deadline; // The current job's shared deadline - connect and response must fit before it
+    FreeSleepArena arena;
+    unsigned long lastUsed;
+    uint32_t requests;      // Requests served on the current socket
+    uint32_t connects;      // TCP connections opened for this controller
+    BreakerState breaker;
+    uint8_t failures;       // Consecutive failed requests
+    unsigned long backoffMs;
+    unsigned long probeAt;  // When an open breaker lets the next request through
+    FreeSleepOpStats ops[FS_OP_COUNT];  // Written by the worker during a job
+    bool opsResetPending;   // Cleared with ops once the worker is idle
+    FreeSleepOperation op;  // Request in progress (send -> finish)
+    unsigned long requestStart;
+    TaskHandle_t worker;
+    FreeSleepJob job;
+    volatile bool busy;     // Worker is still running a job - leave the slot (and its job) alone
+    uint32_t cycle;         // Last cycle that acquired the slot
+};
+
+// Each refresh, write flush or diagnostics run is one cycle; slots it acquires are kept
+// for it until the next one begins
+uint32_t freeSleepCycle = 0;
+
+FreeSleepConnection freeSleepConnections[FREESLEEP_MAX_CONNECTIONS];
+FreeSleepArena freeSleepStreamArena;  // Stream events are parsed here, one at a time on the FreeSleep task
+
+// FreeSleep client task - owns all controller I/O (and the connection pool) on core 0
+// so the UI loop never blocks on the network. The UI submits commands; results
+// come back as events that loop() applies to local state.
+enum FreeSleepCommandType {
+    FS_CMD_WRITE,    // Temperature and/or power for one zone
+    FS_CMD_REFRESH,  // Fetch status for every zone
+    FS_CMD_DISCOVER, // Browse mDNS for controllers now
+    FS_CMD_DIAGNOSE  // Probe every controller in freeSleepDiagnostics
+};
+
+struct FreeSleepCommand {
+    FreeSleepCommandType type;
+    FreeSleepZone zone;
+    uint32_t ip[MAX_ZONES];   // Controller IPs snapshotted at submit time (indexed by zone, 0 = skip)
+    const char* side;         // "left" or "right" (string literal)
+    bool setTemperature;
+    float tempCelsius;
+    bool setPower;
+    bool powerOn;
+    uint32_t sequence;        // Outbox sequence this write carries (echoed in the result)
+};
+
+// Outbound write builder - the task merges every write waiting in the queue into
+// one deviceStatus POST per controller, covering both sides and both fields.
+// Last value wins per field.
+const char* const FREESLEEP_SIDES[2] = {"left", "right"};
+
+struct FreeSleepSideWrite {
+    bool hasTemperature;
+    int tempF;
+    bool hasPower;
+    bool powerOn;
+};
+
+struct FreeSleepWriteBatch {
+    bool used;
+    uint32_t ip;
+    FreeSleepSideWrite sides[2];  // Indexed like FREESLEEP_SIDES
+    uint8_t zoneMask;             // Zones waiting on this POST's result
+    uint32_t sequence[MAX_ZONES];
+};
+
+enum FreeSleepEventType {
+    FS_EVT_STATUS,         // Status fetched for one zone
+    FS_EVT_SYNC_COMPLETE,  // Refresh finished for all zones
+    FS_EVT_WRITE_RESULT,   // Combined deviceStatus POST finished
+    FS_EVT_CONTROLLER_FOUND  // mDNS discovery answer
+};
+
+const int FREESLEEP_NAME_LEN = 32;  // mDNS host name, including terminator
+
+struct FreeSleepEvent {
+    FreeSleepEventType type;
+    FreeSleepZone zone;
+    bool success;
+    float tempCelsius;
+    bool isOn;
+    uint32_t fingerprint;  // Hash of the fields read from the status (0 = none)
+    uint32_t durationMs;   // FS_EVT_SYNC_COMPLETE: how long the refresh took
+    uint32_t allocations;  // FS_EVT_SYNC_COMPLETE: heap allocations made during the refresh
+    uint32_t sequence;     // WRITE_RESULT: sequence that was sent. STATUS: highest sequence acknowledged before the read
+    uint32_t ip;           // FS_EVT_CONTROLLER_FOUND: address and identity of a controller
+    uint16_t port;
+    char name[FREESLEEP_NAME_LEN];
+};
+
+const int FREESLEEP_COMMAND_QUEUE_LEN = 8;
+const int FREESLEEP_EVENT_QUEUE_LEN = 16;
+const uint32_t FREESLEEP_TASK_STACK = 8192;
+const BaseType_t FREESLEEP_TASK_CORE = 0;  // Arduino loop() runs on core 1
+
+QueueHandle_t freeSleepCommandQueue = nullptr;
+QueueHandle_t freeSleepEventQueue = nullptr;
+TaskHandle_t freeSleepTaskHandle = nullptr;
+EventGroupHandle_t freeSleepJobsDone = nullptr;  // One bit per connection slot
+
+// Diagnostics for /api/debug/test-freesleep - a fresh read-only GET to every controller at
+// once, each phase timed. A POST fills in the targets and queues FS_CMD_DIAGNOSE without
+// waiting; the task fills in the probes (zones sharing a controller share one) and marks the
+// run done, and a GET reads it back. A GET with no run going and no unread results starts
+// one, so callers that only ever GET still get a fresh check by polling. Whoever doesn't own the struct in the current state
+// leaves it alone. Nothing is written to the pods and the breakers and histograms are left alone.
+enum DiagnosticsState {
+    DIAGNOSTICS_IDLE,     // Never run
+    DIAGNOSTICS_RUNNING,  // Owned by the task
+    DIAGNOSTICS_DONE      // Owned by the web server until the next run starts
+};
+
+const char* const DIAGNOSTICS_STATE_NAMES[] = {"idle", "running", "done"};
+
+struct FreeSleepDiagnostics {
+    uint32_t ip[MAX_ZONES];                    // Per zone, 0 = skip
+    char host[MAX_ZONES][FREESLEEP_NAME_LEN];  // Controller identity, "" if bound by IP only
+    FreeSleepProbe probes[MAX_ZONES];
+    int32_t rssi;                              // WiFi link when the probes ran
+    int32_t channel;
+    uint32_t durationMs;
+    unsigned long startedAt;
+    unsigned long finishedAt;
+    bool reported;                             // A GET has returned these results
+};
+
+FreeSleepDiagnostics freeSleepDiagnostics;
+volatile DiagnosticsState freeSleepDiagnosticsState = DIAGNOSTICS_IDLE;
+
+// Change detection for polled status - a poll whose fingerprint matches the last one
+// fully applied to a zone skips the state comparison and redraw.
+// Exposed on /api/debug/sync-stats.
+uint32_t zoneFingerprint[MAX_ZONES] = {};
+
+struct FreeSleepSyncStats {
+    uint32_t unchanged;  // Polls skipped by fingerprint match
+    uint32_t changed;    // Polls applied to local state
+    uint32_t failed;     // Polls with no usable status
+    uint32_t suppressed; // Writes skipped - the pod already held that whole °F
+};
+
+FreeSleepSyncStats syncStats[MAX_ZONES];
+
+// Outbound write queue - one entry per zone, last value wins per field. An entry stays
+// until the pod acknowledges it, retrying with backoff, and is replayed as soon as its
+// controller answers a poll again. Entries that outlive their first attempt are saved
+// to NVS and restored after a reboot (a change that succeeds first time never touches flash).
+const unsigned long OUTBOX_RETRY_MIN_MS = 2000;
+const unsigned long OUTBOX_RETRY_MAX_MS = 60000;
+const unsigned long OUTBOX_RESULT_TIMEOUT_MS = 15000;  // Give up waiting on a lost result
+
+struct OutboxEntry {
+    bool hasTemperature;
+    float tempCelsius;
+    bool hasPower;
+    bool powerOn;
+    unsigned long queuedAt;     // Oldest unacknowledged change
+    unsigned long nextAttempt;
+    unsigned long retryMs;
+    unsigned long sentAt;
+    uint16_t attempts;
+    bool inFlight;
+    bool persisted;
+    uint32_t sequence;          // Bumped on every change; a result only clears the value it was sent with
+    int sentTempF;              // Whole °F carried by the write in flight, 0 if it has no temperature
+};
+
+OutboxEntry outbox[MAX_ZONES];
+
+// Versioned reconciliation - every local change takes the next sequence number, and each
+// field remembers the sequence of its last local change. With every status the task reports
+// the highest sequence the pod had acknowledged before the status was read; a field changed
+// locally after that is a stale echo and is ignored, however slow the pod is.
+uint32_t localSequence = 0;
+uint32_t temperatureVersion[MAX_ZONES] = {};
+uint32_t powerVersion[MAX_ZONES] = {};
+uint32_t ackedSequence[MAX_ZONES] = {};  // Owned by the FreeSleep task
+
+// The pod only stores whole °F, so each zone remembers the setpoint the pod last acknowledged
+// or reported, in its own units, and the sequence it was current as of. A dial change that
+// rounds to the same °F never goes out (the local setpoint keeps its full precision).
+int podTempF[MAX_ZONES] = {};  // 0 = not known yet
+uint32_t podTempSequence[MAX_ZONES] = {};
+
+// NVS form of the outbox, stored under "outbox" (one record per zone)
+struct OutboxRecord {
+    uint8_t hasTemperature;
+    uint8_t hasPower;
+    uint8_t powerOn;
+    float tempCelsius;
+};
+
+// Controller discovery - a low-priority task of its own browses mDNS (DNS-SD) for controllers
+// in the background and reports each answer; loop() keeps them in a resolution table with a TTL.
+// Zones remember their controller's host name, so when DHCP moves a pod the zone follows it.
+// A breaker opening triggers an early re-browse. A browse blocks for seconds, so it never runs
+// on the task that flushes writes, and nothing here ever blocks the UI.
+const unsigned long FREESLEEP_DISCOVERY_INTERVAL_MS = 600000;  // Routine browse every 10 minutes
+const unsigned long FREESLEEP_DISCOVERY_MIN_GAP_MS = 20000;    // Breaker-triggered browses no closer than this
+const unsigned long FREESLEEP_DISCOVERY_TTL_MS = 1800000;      // Table entries expire after 30 minutes
+const int FREESLEEP_DISCOVERY_MAX = 8;
+
+struct DiscoveredController {
+    bool valid;
+    char name[FREESLEEP_NAME_LEN];
+    uint32_t ip;
+    uint16_t port;
+    unsigned long expiresAt;
+};
+
+DiscoveredController discoveredControllers[FREESLEEP_DISCOVERY_MAX];
+
+// Discovery task state (requests are also flagged from the FreeSleep task)
+TaskHandle_t freeSleepDiscoveryTaskHandle = nullptr;
+volatile bool mdnsStarted = false;
+volatile bool discoveryRequested = false;
+volatile unsigned long lastDiscovery = 0;
+
+// Push subscription - a Server-Sent Events stream per controller (the pod itself, or a
+// local bridge in front of it) delivers status changes as they happen. While every
+// controller's stream is live, polling drops to a slow safety resync; a controller with
+// no stream, or a stream that goes quiet, puts the dial back on normal polling.
+const char* const FREESLEEP_STREAM_PATH = "/api/deviceStatus/stream";
+const unsigned long FREESLEEP_STREAM_RETRY_MS = 30000;  // Between subscribe attempts per controller
+const unsigned long FREESLEEP_STREAM_IDLE_MS = 45000;   // No data or keep-alive comment for this long = dead
+const unsigned long FREESLEEP_PUSH_RESYNC_MS = 60000;   // Poll interval while push is live
+const TickType_t FREESLEEP_STREAM_POLL_TICKS = pdMS_TO_TICKS(50);  // Task wakes this often to read streams
+const size_t FREESLEEP_STREAM_MAX_EVENT = 2048;         // Longer events are dropped
+// Opening a stream runs on the task that flushes writes, so connect and the response head
+// get a short budget of their own - a pod on the LAN answers in tens of milliseconds
+const unsigned long FREESLEEP_STREAM_OPEN_MS = 300;
+
+struct FreeSleepStream {
+    bool assigned;
+    IPAddress ip;
+    char host[24];               // <ip>:3000 for the Host header and logs, formatted when the slot is assigned
+    WiFiClient client;
+    bool connected;
+    // The event's data so far is event[0, dataLength); the SSE line being received follows it,
+    // up to length. A data line's payload is moved down onto the data when the line ends.
+    char event[FREESLEEP_STREAM_MAX_EVENT];
+    size_t dataLength;
+    size_t length;
+    bool overflow;               // The event outgrew the buffer and will be dropped
+    unsigned long lastAttempt;
+    unsigned long lastActivity;
+    uint32_t connects;
+    uint32_t events;
+};
+
+FreeSleepStream freeSleepStreams[FREESLEEP_MAX_CONNECTIONS];
+volatile bool freeSleepPushLive = false;  // Written by the task, read by loop()
+uint32_t syncedTargetIP[MAX_ZONES] = {};  // Controllers the last refresh (and so the streams) targeted
+const char* syncedSide = nullptr;
 
 // Web server
 WebServer server(API_PORT);
@@ -118,8 +622,77 @@ const int centerY = SCREEN_HEIGHT / 2;
 const int arcRadius = 100;
 const int arcThickness = 15;
 
-// Sprite for double buffering
-LGFX_Sprite sprite(&M5Dial.Display);
+// Sprite for double buffering. It counts the drawing calls made on it for render profiling:
+// these forwards hide LGFX_Sprite's own, so every call made on `sprite` goes through them.
+// Helpers that draw through a LovyanGFX* count for themselves when handed the sprite.
+class ProfiledSprite : public LGFX_Sprite {
+public:
+    using LGFX_Sprite::LGFX_Sprite;
+
+    uint32_t primitives = 0;  // Since the last frame was pushed
+
+    template <typename... Args> void fillSprite(Args&&... args) { primitives++; LGFX_Sprite::fillSprite(std::forward<Args>(args)...); }
+    template <typename... Args> void fillRect(Args&&... args) { primitives++; LGFX_Sprite::fillRect(std::forward<Args>(args)...); }
+    template <typename... Args> void fillRoundRect(Args&&... args) { primitives++; LGFX_Sprite::fillRoundRect(std::forward<Args>(args)...); }
+    template <typename... Args> void fillCircle(Args&&... args) { primitives++; LGFX_Sprite::fillCircle(std::forward<Args>(args)...); }
+    template <typename... Args> void drawRect(Args&&... args) { primitives++; LGFX_Sprite::drawRect(std::forward<Args>(args)...); }
+    template <typename... Args> void drawCircle(Args&&... args) { primitives++; LGFX_Sprite::drawCircle(std::forward<Args>(args)...); }
+    template <typename... Args> void drawLine(Args&&... args) { primitives++; LGFX_Sprite::drawLine(std::forward<Args>(args)...); }
+    template <typename... Args> decltype(auto) drawString(Args&&... args) {
+        primitives++;
+        return LGFX_Sprite::drawString(std::forward<Args>(args)...);
+    }
+
+    // Copy a pre-rendered strip into the frame
+    void blit(LGFX_Sprite& source, int32_t x, int32_t y) {
+        primitives++;
+        source.pushSprite(this, x, y);
+    }
+};
+
+ProfiledSprite sprite(&M5Dial.Display);
+
+// Text layout cache - measured width and pre-rendered strip per (string, font, colour)
+// Menu and WiFi labels are blitted from here instead of being re-rasterised on every redraw
+const int TEXT_CACHE_SIZE = 16;
+const int LABEL_MAX_WIDTH = 170;  // Widest label that fits between the selection arrows
+
+struct TextLayout {
+    bool valid;
+    uint32_t hash;
+    String text;
+    const lgfx::IFont* font;
+    uint16_t fgColor;
+    uint16_t bgColor;
+    int width;
+    int height;
+    unsigned long lastUsed;
+    LGFX_Sprite strip;
+};
+
+TextLayout textCache[TEXT_CACHE_SIZE];
+unsigned long textCacheClock = 0;  // Increments on every lookup, used for LRU eviction
+
+// Marquee for the active label when it's wider than LABEL_MAX_WIDTH
+// Scrolls by shifting the cached strip inside a small row sprite
+const unsigned long MARQUEE_FRAME_MS = 40;        // ~25 fps
+const unsigned long MARQUEE_HOLD_MS = 1200;       // Pause at the start of each pass
+const int MARQUEE_STEP_PX = 2;
+const int MARQUEE_GAP_PX = 40;                    // Blank space between repeats
+
+struct MarqueeState {
+    bool active;
+    TextLayout* layout;
+    uint32_t hash;
+    int x;
+    int y;
+    int offset;
+    unsigned long lastFrame;
+    unsigned long holdUntil;
+};
+
+MarqueeState marquee = {false, nullptr, 0, 0, 0, 0, 0, 0};
+LGFX_Sprite marqueeRow(&M5Dial.Display);
 
 // Function prototypes
 void setupWiFi();
@@ -131,43 +704,161 @@ void drawIPEditor();
 void drawWiFiScanner();
 void drawPasswordEntry();
 void updateClockDisplay();
+void enterAmbientFace();
+void exitAmbientFace();
+void drawAmbientFace();
+void drawAmbientTime(LovyanGFX* dst, int x, int y, uint16_t color);
+void updateAmbientClock();
+TextLayout& getTextLayout(const char* text, const lgfx::IFont* font, uint16_t fgColor, uint16_t bgColor);
+void drawCachedLabel(const char* text, const lgfx::IFont* font, uint16_t fgColor, uint16_t bgColor,
+                     int x, int y, int maxWidth);
+void drawMarqueeLabel(const char* text, const lgfx::IFont* font, uint16_t fgColor, uint16_t bgColor,
+                      int x, int y);
+void pushMarqueeStrip(LovyanGFX* dst, int left, int top);
+void updateMarquee();
+int labelWidthAt(int y);
 void drawArc(int startAngle, int endAngle, uint16_t color);
+void pushFrame(RenderScreen screen, unsigned long renderStart);
+void recordPartialPush(unsigned long pushStart, uint32_t pixels);
+void renderScreen(RenderScreen screen);
+void redrawCurrentScreen();
+void handleAPIRenderStats();
+void handleAPIRenderStatsConfig();
+void handleAPISyncStats();
+void handleAPIRenderBench();
+void handleAPIStartRenderBench();
+void serviceRenderBench();
+uint32_t countDirtyPixels();
+void handleAPIScreenshot();
 void handleEncoderInput();
 void handleEncoderInSettings();
 void handleEncoderInIPEditor();
 void handleEncoderInWiFiScanner();
 void handleEncoderInPasswordEntry();
 void handleTouchInput();
+void updatePressRing();
+void fillPressRingArc(int fromAngle, int toAngle, uint16_t color);
+void openSettingsFromHold(unsigned long holdDuration);
 void handleAPIRoot();
 void handleAPITemperature();
 void handleAPISetTemperature();
-void handleAPIBedTemperature();
-void handleAPISetBedTemperature();
-void handleAPIPillowTemperature();
-void handleAPISetPillowTemperature();
+void handleAPIZoneTemperature(FreeSleepZone zone);
+void handleAPISetZoneTemperature(FreeSleepZone zone, const char* side = nullptr);
+void handleAPIZoneIP(FreeSleepZone zone);
+void handleAPISetZoneIP(FreeSleepZone zone);
+void handleAPIZones();
+void handleAPISetZones();
+bool zoneFromArg(FreeSleepZone& zone);
 void handleNotFound();
 void updateBrightness();
 void recordActivity();
 bool isNightTime();
-uint16_t getTemperatureColor(float temp);
-uint16_t getTemperatureColorNight(float temp);
+bool isEveningTime();
+ThemeId activeThemeId();
+const Theme& activeTheme();
 float mapFloat(float x, float in_min, float in_max, float out_min, float out_max);
 float& getActiveSetpoint();
-float& getInactiveSetpoint();
-String getMenuItemName(MenuItem item);
-void startIPEditor(bool isBedIP);
+void selectZone(FreeSleepZone zone);
+int menuRowCount();
+MenuItem menuRowItem(int row, FreeSleepZone& zone);
+String getMenuItemName(MenuItem item, FreeSleepZone zone);
+void startIPEditor(FreeSleepZone zone);
 void startWiFiScanner();
 void startPasswordEntry();
 
 // FreeSleep API functions
 float celsiusToFahrenheit(float celsius);
 float fahrenheitToCelsius(float fahrenheit);
-bool fetchFreeSleepTemperature(IPAddress ip, const char* side, float& tempCelsius, bool& isOn);
-bool setFreeSleepTemperature(IPAddress ip, const char* side, float tempCelsius);
-bool setFreeSleepPower(IPAddress ip, const char* side, bool powerOn);
-void syncTemperaturesFromFreeSleep();
+bool fetchFreeSleepStatus(FreeSleepConnection& conn, const JsonDocument& filter, JsonDocument& doc);
+void addFreeSleepSideFilter(JsonDocument& filter, const char* side);
+const JsonDocument& freeSleepStatusFilter(const char* side);
+bool readFreeSleepSide(JsonVariantConst status, const char* side, float& tempCelsius, bool& isOn);
+uint32_t freeSleepFingerprint(float tempCelsius, bool isOn);
+int freeSleepTempF(float tempCelsius);
+void queueFreeSleepWrite(FreeSleepWriteBatch* batches, const FreeSleepCommand& command);
+int formatFreeSleepWrite(const FreeSleepWriteBatch& batch, char* payload, size_t size, FreeSleepOperation& op);
+bool postFreeSleepWrite(FreeSleepConnection& conn, const FreeSleepWriteBatch& batch);
+void flushFreeSleepWrites(FreeSleepWriteBatch* batches, const FreeSleepCommand* subscription);
+void runFreeSleepRefresh(const FreeSleepCommand& command);
+void serviceFreeSleepStreams(const FreeSleepCommand& target);
+FreeSleepStream& acquireFreeSleepStream(IPAddress ip, const FreeSleepCommand& target);
+bool openFreeSleepStream(FreeSleepStream& stream);
+void closeFreeSleepStream(FreeSleepStream& stream, const char* reason);
+void readFreeSleepStream(FreeSleepStream& stream, const FreeSleepCommand& target);
+void drainFreeSleepStreams(const FreeSleepCommand& target);
+void dispatchFreeSleepStreamEvent(FreeSleepStream& stream, const FreeSleepCommand& target);
+bool freeSleepTargetsChanged();
+unsigned long freeSleepSyncInterval();
+FreeSleepConnection& acquireFreeSleepConnection(IPAddress ip);
+const FreeSleepConnection* findFreeSleepConnection(IPAddress ip);
+int sendFreeSleepRequest(FreeSleepConnection& conn, FreeSleepOperation op, const char* payload);
+void finishFreeSleepRequest(FreeSleepConnection& conn, int httpCode);
+int readFreeSleepResponseHead(FreeSleepConnection& conn);
+bool readFreeSleepLine(FreeSleepConnection& conn, char* line, size_t size);
+bool readFreeSleepLine(WiFiClient& client, unsigned long deadline, char* line, size_t size);
+int readFreeSleepByte(FreeSleepConnection& conn);
+int readFreeSleepByte(WiFiClient& client, unsigned long deadline);
+int readFreeSleepBody(FreeSleepConnection& conn);
+int endFreeSleepBody(FreeSleepConnection& conn, bool complete);
+void recordLatency(LatencyHistogram& histogram, uint32_t micros);
+FreeSleepResultClass classifyFreeSleepResult(int httpCode);
+void handleAPIFreeSleepStats();
+void handleAPITestFreeSleep();
+void handleAPIStartFreeSleepTest();
+float latencyPercentileMs(const LatencyHistogram& histogram, int percentile);
+void runFreeSleepDiagnostics();
+void probeFreeSleepController(FreeSleepConnection& conn, char* host, FreeSleepProbe& probe);
+int formatFreeSleepRequest(const FreeSleepConnection& conn, const char* payload, char* request, size_t size);
+bool freeSleepBreakerAllows(FreeSleepConnection& conn, bool probe);
+void recordFreeSleepResult(FreeSleepConnection& conn, bool success);
+void runFreeSleepDiscovery();
+bool freeSleepDiscoveryDue();
+void freeSleepDiscoveryTask(void* param);
+void handleControllerFound(const FreeSleepEvent& event);
+void bindZonesToControllers();
+const DiscoveredController* findDiscoveredController(const char* name, uint32_t ip);
+String& zoneControllerName(FreeSleepZone zone);
+void setZoneController(FreeSleepZone zone, const String& name);
+void saveZoneTargetIP(FreeSleepZone zone);
+void loadZones();
+void saveZoneLayout();
+String zoneKey(FreeSleepZone zone);
+void handleAPIDiscovery();
 void syncFromFreeSleep();
 void toggleActivePower();
+void startFreeSleepTask();
+void countFreeSleepAllocation();
+void freeSleepTask(void* param);
+void freeSleepWorker(void* param);
+EventBits_t freeSleepJobBit(const FreeSleepConnection& conn);
+EventBits_t startFreeSleepJob(FreeSleepConnection& conn, unsigned long deadline);
+EventBits_t waitFreeSleepJobs(EventBits_t jobs, unsigned long deadline);
+void postFreeSleepEvent(const FreeSleepEvent& event);
+bool submitFreeSleepCommand(const FreeSleepCommand& command);
+void requestFreeSleepTemperature(FreeSleepZone zone, float tempCelsius);
+void requestFreeSleepSideTemperature(FreeSleepZone zone, const char* side, float tempCelsius);
+void requestFreeSleepWrite(FreeSleepZone zone, bool setTemperature, float tempCelsius, bool setPower, bool powerOn);
+bool outboxPending(FreeSleepZone zone);
+uint32_t markLocalChange(FreeSleepZone zone, bool temperature, bool power);
+void scheduleFreeSleepUpdate();
+void sendPendingFreeSleepUpdate();
+unsigned long freeSleepDebounceWindow();
+void serviceOutbox();
+void handleOutboxResult(const FreeSleepEvent& event);
+void saveOutbox();
+void dropOutboxEntry(FreeSleepZone zone);
+void loadOutbox();
+void processFreeSleepEvents();
+bool applyFreeSleepStatus(const FreeSleepEvent& event);
+float& zoneSetpoint(FreeSleepZone zone);
+bool& zonePowerOn(FreeSleepZone zone);
+IPAddress& zoneTargetIP(FreeSleepZone zone);
+int zoneOnController(IPAddress ip, int except);
+bool zoneControllerShadowed(FreeSleepZone zone);
+const char* zoneName(FreeSleepZone zone);
+const char* activeSide();
+void loadSettings();
+void setupDisplay();
 
 void setup() {
     // Initialize M5Dial
@@ -179,45 +870,10 @@ void setup() {
     Serial.println("====================================");
 
     // Load saved settings from NVS
-    preferences.begin("tempctrl", false);
-    bedTargetIP = IPAddress(
-        preferences.getUChar("bedIP0", 192),
-        preferences.getUChar("bedIP1", 168),
-        preferences.getUChar("bedIP2", 1),
-        preferences.getUChar("bedIP3", 100)
-    );
-    pillowTargetIP = IPAddress(
-        preferences.getUChar("pillowIP0", 192),
-        preferences.getUChar("pillowIP1", 168),
-        preferences.getUChar("pillowIP2", 1),
-        preferences.getUChar("pillowIP3", 101)
-    );
-    Serial.printf("Loaded Bed IP: %s\n", bedTargetIP.toString().c_str());
-    Serial.printf("Loaded Pillow IP: %s\n", pillowTargetIP.toString().c_str());
-
-    // Load saved WiFi credentials
-    savedWifiSSID = preferences.getString("wifiSSID", "");
-    savedWifiPassword = preferences.getString("wifiPass", "");
-    if (savedWifiSSID.length() > 0) {
-        Serial.printf("Loaded saved WiFi: %s\n", savedWifiSSID.c_str());
-    }
-
-    // Load bed side setting
-    bedSideRight = preferences.getBool("bedSideRight", false);
-    Serial.printf("Loaded bed side: %s\n", bedSideRight ? "Right" : "Left");
-
-    // Load temperature unit setting
-    useFahrenheit = preferences.getBool("useFahrenheit", false);
-    Serial.printf("Loaded temp unit: %s\n", useFahrenheit ? "Fahrenheit" : "Celsius");
+    loadSettings();
 
-    // Initialize display
-    M5Dial.Display.setRotation(0);
-    M5Dial.Display.fillScreen(COLOR_BACKGROUND);
-    M5Dial.Display.setTextColor(COLOR_TEXT);
-    M5Dial.Display.setTextDatum(middle_center);
-
-    // Create sprite for double buffering
-    sprite.createSprite(SCREEN_WIDTH, SCREEN_HEIGHT);
+    // Initialize display and the frame sprite
+    setupDisplay();
 
     // Show startup message
     M5Dial.Display.setTextSize(1);
@@ -229,6 +885,9 @@ void setup() {
     // Setup web server
     setupWebServer();
 
+    // Start the FreeSleep client task (network I/O off the UI loop)
+    startFreeSleepTask();
+
     // Setup NTP time sync
     setupNTP();
 
@@ -243,13 +902,48 @@ void setup() {
     lastActivityTime = millis();
     recordActivity();
 
-    // Initialize night mode state
-    wasNightMode = isNightTime();
+    // Initialize theme state
+    lastThemeId = activeThemeId();
 
     // Draw initial UI
     drawTemperatureUI();
 }
 
+// Settings saved in NVS: zones, WiFi, bed side, unit and unacknowledged writes
+void loadSettings() {
+    preferences.begin("tempctrl", false);
+    loadZones();
+
+    // Load saved WiFi credentials
+    savedWifiSSID = preferences.getString("wifiSSID", "");
+    savedWifiPassword = preferences.getString("wifiPass", "");
+    if (savedWifiSSID.length() > 0) {
+        Serial.printf("Loaded saved WiFi: %s\n", savedWifiSSID.c_str());
+    }
+
+    // Load bed side setting
+    bedSideRight = preferences.getBool("bedSideRight", false);
+    Serial.printf("Loaded bed side: %s\n", bedSideRight ? "Right" : "Left");
+
+    // Load temperature unit setting
+    useFahrenheit = preferences.getBool("useFahrenheit", false);
+    Serial.printf("Loaded temp unit: %s\n", useFahrenheit ? "Fahrenheit" : "Celsius");
+
+    // Restore writes the pods never acknowledged before the last reboot
+    loadOutbox();
+}
+
+// Display defaults and the full-screen sprite every frame is composed in
+void setupDisplay() {
+    M5Dial.Display.setRotation(0);
+    M5Dial.Display.fillScreen(activeTheme().background);
+    M5Dial.Display.setTextColor(activeTheme().text);
+    M5Dial.Display.setTextDatum(middle_center);
+
+    // Create sprite for double buffering
+    sprite.createSprite(SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
 void loop() {
     M5Dial.update();
 
@@ -263,52 +957,63 @@ void loop() {
 
     // Handle touch input
     handleTouchInput();
+    updatePressRing();
 
     // Update brightness based on activity and time
     updateBrightness();
 
     // Update clock display every second (only on main temperature screen)
+    // The ambient face replaces this with a once-a-minute update
     unsigned long currentMillis = millis();
-    if (!inSettingsMenu && currentMillis - lastClockUpdate >= 1000) {
+    if (ambientFaceActive) {
+        updateAmbientClock();
+    } else if (!inSettingsMenu && currentMillis - lastClockUpdate >= 1000) {
         lastClockUpdate = currentMillis;
         updateClockDisplay();
     }
 
+    // Scroll the active carousel label if it's too wide for the screen
+    if (inSettingsMenu && (currentSubMenu == SUBMENU_NONE || currentSubMenu == SUBMENU_WIFI_SCAN)) {
+        updateMarquee();
+    }
+
+    // Apply results coming back from the FreeSleep task
+    processFreeSleepEvents();
+
+    // One render benchmark case per pass, if one is running
+    serviceRenderBench();
+
     // Handle debounced FreeSleep API updates
-    if (pendingFreeSleepUpdate && (currentMillis - lastSetpointChangeTime >= FREESLEEP_DEBOUNCE_MS)) {
-        pendingFreeSleepUpdate = false;
-        // Skip updates if we've had consecutive failures (pods unreachable)
-        if (!skipUserUpdates) {
-            const char* side = bedSideRight ? "right" : "left";
-            if (pillowModeActive) {
-                setFreeSleepTemperature(pillowTargetIP, side, pillowSetpoint);
-            } else {
-                setFreeSleepTemperature(bedTargetIP, side, bedSetpoint);
-            }
-        } else {
-            Serial.println("Skipping user update - pods unreachable");
-        }
+    if (pendingFreeSleepUpdate && (currentMillis - lastSetpointChangeTime >= freeSleepDebounceWindow())) {
+        sendPendingFreeSleepUpdate();
     }
 
+    // Send, retry or replay queued writes
+    serviceOutbox();
+
     // Periodic sync from FreeSleep (temperature and power state)
-    // Uses exponential backoff when failing to prevent UI freezing
-    if (wifiConnected && !inSettingsMenu && !pendingFreeSleepUpdate &&
-        (currentMillis - lastFreeSleepSync >= currentSyncInterval)) {
+    // One refresh in flight at a time; the task skips controllers whose breaker is open.
+    // With push streams live this is only a safety net, unless the controllers changed.
+    unsigned long syncInterval = (freeSleepPushLive && !freeSleepTargetsChanged()) ?
+                                 FREESLEEP_PUSH_RESYNC_MS : freeSleepSyncInterval();
+    if (wifiConnected && !inSettingsMenu && !pendingFreeSleepUpdate && !syncInFlight &&
+        (currentMillis - lastFreeSleepSync >= syncInterval)) {
         lastFreeSleepSync = currentMillis;
         syncFromFreeSleep();
     }
 
-    // Check for night mode changes (independent of FreeSleep sync)
+    // Check for theme changes - evening/night mode (independent of FreeSleep sync)
     if (!inSettingsMenu) {
-        bool currentNightMode = isNightTime();
-        if (currentNightMode != wasNightMode) {
-            wasNightMode = currentNightMode;
-            Serial.printf("Night mode changed to: %s\n", currentNightMode ? "ON" : "OFF");
+        ThemeId currentThemeId = activeThemeId();
+        if (currentThemeId != lastThemeId) {
+            lastThemeId = currentThemeId;
+            Serial.printf("Theme changed to: %s\n",
+                         currentThemeId == THEME_NIGHT ? "Night" : currentThemeId == THEME_EVENING ? "Evening" : "Day");
             drawTemperatureUI();
         }
     }
 
-    delay(10);
+    delay(ambientFaceActive ? AMBIENT_LOOP_DELAY_MS : 10);
 }
 
 void setupWiFi() {
@@ -331,6 +1036,8 @@ void setupWiFi() {
     WiFi.mode(WIFI_STA);
     WiFi.begin(ssid, password);
 
+    const Theme& theme = activeTheme();
+
     int attempts = 0;
     while (WiFi.status() != WL_CONNECTED && attempts < 30) {
         delay(500);
@@ -338,7 +1045,7 @@ void setupWiFi() {
         attempts++;
 
         // Show connection progress
-        M5Dial.Display.fillScreen(COLOR_BACKGROUND);
+        M5Dial.Display.fillScreen(theme.background);
         M5Dial.Display.setTextSize(1);
         M5Dial.Display.drawString("Connecting to WiFi", centerX, centerY - 20);
 
@@ -354,10 +1061,10 @@ void setupWiFi() {
         Serial.printf("IP Address: %s\n", WiFi.localIP().toString().c_str());
 
         // Show success message briefly
-        M5Dial.Display.fillScreen(COLOR_BACKGROUND);
-        M5Dial.Display.setTextColor(COLOR_SETPOINT);
+        M5Dial.Display.fillScreen(theme.background);
+        M5Dial.Display.setTextColor(theme.setpoint);
         M5Dial.Display.drawString("WiFi Connected!", centerX, centerY - 20);
-        M5Dial.Display.setTextColor(COLOR_TEXT);
+        M5Dial.Display.setTextColor(theme.text);
         M5Dial.Display.drawString(WiFi.localIP().toString().c_str(), centerX, centerY + 10);
         delay(2000);
     } else {
@@ -365,10 +1072,10 @@ void setupWiFi() {
         Serial.println("\nWiFi Connection Failed!");
 
         // Show error message
-        M5Dial.Display.fillScreen(COLOR_BACKGROUND);
-        M5Dial.Display.setTextColor(COLOR_ARC_HOT);
+        M5Dial.Display.fillScreen(theme.background);
+        M5Dial.Display.setTextColor(theme.arcHot);
         M5Dial.Display.drawString("WiFi Failed!", centerX, centerY - 10);
-        M5Dial.Display.setTextColor(COLOR_TEXT);
+        M5Dial.Display.setTextColor(theme.text);
         M5Dial.Display.drawString("Running offline", centerX, centerY + 10);
         delay(2000);
     }
@@ -381,104 +1088,73 @@ void setupWebServer() {
     server.on("/", HTTP_GET, handleAPIRoot);
     server.on("/api/temperature", HTTP_GET, handleAPITemperature);
     server.on("/api/temperature", HTTP_POST, handleAPISetTemperature);
-    server.on("/api/bed", HTTP_GET, handleAPIBedTemperature);
-    server.on("/api/bed", HTTP_POST, handleAPISetBedTemperature);
-    server.on("/api/pillow", HTTP_GET, handleAPIPillowTemperature);
-    server.on("/api/pillow", HTTP_POST, handleAPISetPillowTemperature);
-    server.on("/api/config/bed-ip", HTTP_GET, []() {
-        JsonDocument doc;
-        doc["ip"] = bedTargetIP.toString();
-        String response;
-        serializeJson(doc, response);
-        server.send(200, "application/json", response);
+    server.on("/api/bed", HTTP_GET, []() { handleAPIZoneTemperature(ZONE_BED); });
+    // These two have always written a fixed side of the pod, whatever the dial's bed side
+    server.on("/api/bed", HTTP_POST, []() { handleAPISetZoneTemperature(ZONE_BED, "left"); });
+    server.on("/api/pillow", HTTP_GET, []() { handleAPIZoneTemperature(ZONE_PILLOW); });
+    server.on("/api/pillow", HTTP_POST, []() { handleAPISetZoneTemperature(ZONE_PILLOW, "right"); });
+    server.on("/api/config/bed-ip", HTTP_GET, []() { handleAPIZoneIP(ZONE_BED); });
+    server.on("/api/config/bed-ip", HTTP_POST, []() { handleAPISetZoneIP(ZONE_BED); });
+    server.on("/api/config/pillow-ip", HTTP_GET, []() { handleAPIZoneIP(ZONE_PILLOW); });
+    server.on("/api/config/pillow-ip", HTTP_POST, []() { handleAPISetZoneIP(ZONE_PILLOW); });
+
+    // Any zone by index: /api/zone?id=2, /api/config/zone-ip?id=2
+    server.on("/api/zones", HTTP_GET, handleAPIZones);
+    server.on("/api/zones", HTTP_POST, handleAPISetZones);
+    server.on("/api/zone", HTTP_GET, []() {
+        FreeSleepZone zone;
+        if (zoneFromArg(zone)) handleAPIZoneTemperature(zone);
     });
-    server.on("/api/config/bed-ip", HTTP_POST, []() {
-        if (server.hasArg("plain")) {
-            JsonDocument doc;
-            DeserializationError error = deserializeJson(doc, server.arg("plain"));
-            if (!error && doc.containsKey("ip")) {
-                String ipStr = doc["ip"].as<String>();
-                if (bedTargetIP.fromString(ipStr)) {
-                    Serial.printf("Bed target IP set to: %s\n", bedTargetIP.toString().c_str());
-                    server.send(200, "application/json", "{\"success\":true}");
-                    return;
-                }
-            }
-        }
-        server.send(400, "application/json", "{\"error\":\"Invalid IP address\"}");
+    server.on("/api/zone", HTTP_POST, []() {
+        FreeSleepZone zone;
+        if (zoneFromArg(zone)) handleAPISetZoneTemperature(zone);
     });
-    server.on("/api/config/pillow-ip", HTTP_GET, []() {
-        JsonDocument doc;
-        doc["ip"] = pillowTargetIP.toString();
-        String response;
-        serializeJson(doc, response);
-        server.send(200, "application/json", response);
+    server.on("/api/config/zone-ip", HTTP_GET, []() {
+        FreeSleepZone zone;
+        if (zoneFromArg(zone)) handleAPIZoneIP(zone);
     });
-    server.on("/api/config/pillow-ip", HTTP_POST, []() {
-        if (server.hasArg("plain")) {
-            JsonDocument doc;
-            DeserializationError error = deserializeJson(doc, server.arg("plain"));
-            if (!error && doc.containsKey("ip")) {
-                String ipStr = doc["ip"].as<String>();
-                if (pillowTargetIP.fromString(ipStr)) {
-                    Serial.printf("Pillow target IP set to: %s\n", pillowTargetIP.toString().c_str());
-                    server.send(200, "application/json", "{\"success\":true}");
-                    return;
-                }
-            }
-        }
-        server.send(400, "application/json", "{\"error\":\"Invalid IP address\"}");
+    server.on("/api/config/zone-ip", HTTP_POST, []() {
+        FreeSleepZone zone;
+        if (zoneFromArg(zone)) handleAPISetZoneIP(zone);
     });
 
-    // Debug endpoint to test FreeSleep connection
-    server.on("/api/debug/test-freesleep", HTTP_GET, []() {
-        const char* side = bedSideRight ? "right" : "left";
-
-        // Test bed connection
-        HTTPClient httpBed;
-        String bedUrl = "http://" + bedTargetIP.toString() + ":3000/api/deviceStatus";
-        httpBed.begin(bedUrl);
-        httpBed.addHeader("Content-Type", "application/json");
-        httpBed.setTimeout(2000);
-        httpBed.setConnectTimeout(2000);
-        int tempF = (int)round(celsiusToFahrenheit(bedSetpoint));
-        JsonDocument docBed;
-        docBed[side]["targetTemperatureF"] = tempF;
-        String payloadBed;
-        serializeJson(docBed, payloadBed);
-        int bedCode = httpBed.POST(payloadBed);
-        httpBed.end();
-
-        // Test pillow connection
-        HTTPClient httpPillow;
-        String pillowUrl = "http://" + pillowTargetIP.toString() + ":3000/api/deviceStatus";
-        httpPillow.begin(pillowUrl);
-        httpPillow.addHeader("Content-Type", "application/json");
-        httpPillow.setTimeout(2000);
-        httpPillow.setConnectTimeout(2000);
-        tempF = (int)round(celsiusToFahrenheit(pillowSetpoint));
-        JsonDocument docPillow;
-        docPillow[side]["targetTemperatureF"] = tempF;
-        String payloadPillow;
-        serializeJson(docPillow, payloadPillow);
-        int pillowCode = httpPillow.POST(payloadPillow);
-        httpPillow.end();
-
-        String response = "{";
-        response += "\"bedIP\":\"" + bedTargetIP.toString() + "\",";
-        response += "\"pillowIP\":\"" + pillowTargetIP.toString() + "\",";
-        response += "\"side\":\"" + String(side) + "\",";
-        response += "\"bedSetpoint\":" + String(bedSetpoint) + ",";
-        response += "\"pillowSetpoint\":" + String(pillowSetpoint) + ",";
-        response += "\"bedHttpCode\":" + String(bedCode) + ",";
-        response += "\"pillowHttpCode\":" + String(pillowCode) + ",";
-        response += "\"bedSuccess\":" + String((bedCode == 204 || bedCode == 200) ? "true" : "false") + ",";
-        response += "\"pillowSuccess\":" + String((pillowCode == 204 || pillowCode == 200) ? "true" : "false");
-        response += "}";
+    // Read-only latency breakdown for every controller (nothing is sent to the pods).
+    // POST starts a run in the background, GET reports it.
+    server.on("/api/debug/test-freesleep", HTTP_POST, handleAPIStartFreeSleepTest);
+    server.on("/api/debug/test-freesleep", HTTP_GET, handleAPITestFreeSleep);
+
+    // Controller discovery - GET lists what mDNS has found, POST browses again now
+    server.on("/api/discovery", HTTP_GET, handleAPIDiscovery);
+    server.on("/api/discovery", HTTP_POST, []() {
+        FreeSleepCommand command = {};
+        command.type = FS_CMD_DISCOVER;
+        bool queued = submitFreeSleepCommand(command);
+        server.send(queued ? 202 : 503, "application/json", queued ? "{\"success\":true}" : "{\"error\":\"Busy\"}");
+    });
 
-        server.send(200, "application/json", response);
+    server.on("/api/debug/freesleep-stats", HTTP_GET, handleAPIFreeSleepStats);
+    server.on("/api/debug/freesleep-stats", HTTP_DELETE, []() {
+        freeSleepStatsResetRequested = true;  // The task owns the counters and clears them
+        server.send(200, "application/json", "{\"success\":true}");
     });
 
+    // Render profiling
+    server.on("/api/debug/render-stats", HTTP_GET, handleAPIRenderStats);
+    server.on("/api/debug/render-stats", HTTP_DELETE, []() {
+        memset(renderStats, 0, sizeof(renderStats));
+        server.send(200, "application/json", "{\"success\":true}");
+    });
+    server.on("/api/debug/render-stats", HTTP_POST, handleAPIRenderStatsConfig);
+    server.on("/api/debug/render-bench", HTTP_POST, handleAPIStartRenderBench);
+    server.on("/api/debug/render-bench", HTTP_GET, handleAPIRenderBench);
+    server.on("/api/debug/sync-stats", HTTP_GET, handleAPISyncStats);
+    server.on("/api/debug/sync-stats", HTTP_DELETE, []() {
+        memset(syncStats, 0, sizeof(syncStats));
+        refreshesAllocating = 0;
+        server.send(200, "application/json", "{\"success\":true}");
+    });
+    server.on("/api/debug/screenshot", HTTP_GET, handleAPIScreenshot);
+
     // Update WiFi credentials
     server.on("/api/config/wifi", HTTP_POST, []() {
         if (server.hasArg("plain")) {
@@ -522,12 +1198,18 @@ void handleAPIRoot() {
     html += ".info { color: #888; margin: 10px 0; }";
     html += "</style></head><body>";
     html += "<h1>Temperature Controller</h1>";
-    html += "<h2>" + String(pillowModeActive ? "Pillow" : "Bed") + " Mode</h2>";
+    html += "<h2>" + String(zoneName(activeZone)) + " Mode</h2>";
     html += "<div class='temp'>" + String(getActiveSetpoint(), 1) + "<span class='unit'>&deg;C</span></div>";
-    html += "<p class='info'>Bed: " + String(bedSetpoint, 1) + "&deg;C | Pillow: " + String(pillowSetpoint, 1) + "&deg;C</p>";
+    html += "<p class='info'>";
+    for (int zone = 0; zone < zoneCount; zone++) {
+        if (zone > 0) html += " | ";
+        html += String(zones[zone].name) + ": " + String(zones[zone].setpoint, 1) + "&deg;C";
+    }
+    html += "</p>";
     html += "<p class='info'>API: GET/POST /api/temperature (active)</p>";
     html += "<p class='info'>API: GET/POST /api/bed</p>";
     html += "<p class='info'>API: GET/POST /api/pillow</p>";
+    html += "<p class='info'>API: GET/POST /api/zones, /api/zone?id=N</p>";
     html += "<script>setInterval(()=>location.reload(), 5000);</script>";
     html += "</body></html>";
 
@@ -537,9 +1219,10 @@ void handleAPIRoot() {
 void handleAPITemperature() {
     JsonDocument doc;
     doc["setpoint"] = getActiveSetpoint();
-    doc["mode"] = pillowModeActive ? "pillow" : "bed";
-    doc["bed"] = bedSetpoint;
-    doc["pillow"] = pillowSetpoint;
+    doc["mode"] = zoneKey(activeZone);
+    for (int zone = 0; zone < zoneCount; zone++) {
+        doc[zoneKey(zone)] = zones[zone].setpoint;
+    }
     doc["unit"] = "celsius";
     doc["min"] = TEMP_MIN;
     doc["max"] = TEMP_MAX;
@@ -569,8 +1252,7 @@ void handleAPISetTemperature() {
 
             getActiveSetpoint() = newTemp;
 
-            Serial.printf("%s temperature set via API: %.1f°C\n",
-                         pillowModeActive ? "Pillow" : "Bed", newTemp);
+            Serial.printf("%s temperature set via API: %.1f°C\n", zoneName(activeZone), newTemp);
 
             // Update display
             drawTemperatureUI();
@@ -579,7 +1261,7 @@ void handleAPISetTemperature() {
             JsonDocument responseDoc;
             responseDoc["success"] = true;
             responseDoc["setpoint"] = getActiveSetpoint();
-            responseDoc["mode"] = pillowModeActive ? "pillow" : "bed";
+            responseDoc["mode"] = zoneKey(activeZone);
 
             String response;
             serializeJson(responseDoc, response);
@@ -591,9 +1273,9 @@ void handleAPISetTemperature() {
     server.send(400, "application/json", "{\"error\":\"Missing setpoint parameter\"}");
 }
 
-void handleAPIBedTemperature() {
+void handleAPIZoneTemperature(FreeSleepZone zone) {
     JsonDocument doc;
-    doc["setpoint"] = bedSetpoint;
+    doc["setpoint"] = zones[zone].setpoint;
     doc["unit"] = "celsius";
     doc["min"] = TEMP_MIN;
     doc["max"] = TEMP_MAX;
@@ -604,7 +1286,8 @@ void handleAPIBedTemperature() {
     server.send(200, "application/json", response);
 }
 
-void handleAPISetBedTemperature() {
+// side: the side of the pod to write, or nullptr for the configured bed side
+void handleAPISetZoneTemperature(FreeSleepZone zone, const char* side) {
     if (server.hasArg("plain")) {
         JsonDocument doc;
         DeserializationError error = deserializeJson(doc, server.arg("plain"));
@@ -621,12 +1304,16 @@ void handleAPISetBedTemperature() {
             if (newTemp < TEMP_MIN) newTemp = TEMP_MIN;
             if (newTemp > TEMP_MAX) newTemp = TEMP_MAX;
 
-            bedSetpoint = newTemp;
+            zones[zone].setpoint = newTemp;
 
-            Serial.printf("Bed temperature set via API: %.1f°C\n", bedSetpoint);
+            Serial.printf("%s temperature set via API: %.1f°C\n", zoneName(zone), newTemp);
 
-            // Update FreeSleep API
-            setFreeSleepTemperature(bedTargetIP, "left", bedSetpoint);
+            // Update FreeSleep API (sent by the FreeSleep task)
+            if (side) {
+                requestFreeSleepSideTemperature(zone, side, newTemp);
+            } else {
+                requestFreeSleepTemperature(zone, newTemp);
+            }
 
             // Update display
             drawTemperatureUI();
@@ -634,7 +1321,7 @@ void handleAPISetBedTemperature() {
             // Send response
             JsonDocument responseDoc;
             responseDoc["success"] = true;
-            responseDoc["setpoint"] = bedSetpoint;
+            responseDoc["setpoint"] = newTemp;
 
             String response;
             serializeJson(responseDoc, response);
@@ -646,96 +1333,656 @@ void handleAPISetBedTemperature() {
     server.send(400, "application/json", "{\"error\":\"Missing setpoint parameter\"}");
 }
 
-void handleAPIPillowTemperature() {
+void handleAPIZoneIP(FreeSleepZone zone) {
     JsonDocument doc;
-    doc["setpoint"] = pillowSetpoint;
-    doc["unit"] = "celsius";
-    doc["min"] = TEMP_MIN;
-    doc["max"] = TEMP_MAX;
-
+    doc["ip"] = zones[zone].ip.toString();
+    doc["host"] = zones[zone].controllerName;
     String response;
     serializeJson(doc, response);
-
     server.send(200, "application/json", response);
 }
 
-void handleAPISetPillowTemperature() {
+void handleAPISetZoneIP(FreeSleepZone zone) {
     if (server.hasArg("plain")) {
         JsonDocument doc;
         DeserializationError error = deserializeJson(doc, server.arg("plain"));
-
-        if (error) {
-            server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+        if (!error && doc.containsKey("host")) {
+            // Bind by identity - resolved from the discovery table now or after the next browse
+            setZoneController(zone, doc["host"].as<String>());
+            bindZonesToControllers();
+            server.send(200, "application/json", "{\"success\":true}");
             return;
         }
+        if (!error && doc.containsKey("ip")) {
+            String ipStr = doc["ip"].as<String>();
+            IPAddress ip;
+            int other = ip.fromString(ipStr) ? zoneOnController(ip, zone) : -1;
+            if (other >= 0) {
+                String message = String("{\"error\":\"Controller already used by ") + zoneName(other) + "\"}";
+                server.send(409, "application/json", message);
+                return;
+            }
+            if (zones[zone].ip.fromString(ipStr)) {
+                saveZoneTargetIP(zone);
+                setZoneController(zone, "");
+                Serial.printf("%s target IP set to: %s\n", zoneName(zone), zones[zone].ip.toString().c_str());
+                server.send(200, "application/json", "{\"success\":true}");
+                return;
+            }
+        }
+    }
+    server.send(400, "application/json", "{\"error\":\"Invalid IP address\"}");
+}
 
-        if (doc.containsKey("setpoint")) {
-            float newTemp = doc["setpoint"].as<float>();
-
-            // Clamp to valid range
-            if (newTemp < TEMP_MIN) newTemp = TEMP_MIN;
-            if (newTemp > TEMP_MAX) newTemp = TEMP_MAX;
-
-            pillowSetpoint = newTemp;
-
-            Serial.printf("Pillow temperature set via API: %.1f°C\n", pillowSetpoint);
+// Zone table: names, controllers and current state
+void handleAPIZones() {
+    JsonDocument doc;
+    doc["active"] = activeZone;
+    doc["max"] = MAX_ZONES;
+    JsonArray list = doc["zones"].to<JsonArray>();
+    for (int i = 0; i < zoneCount; i++) {
+        const Zone& zone = zones[i];
+        JsonObject entry = list.add<JsonObject>();
+        entry["id"] = i;
+        entry["key"] = zoneKey(i);
+        entry["name"] = zone.name;
+        entry["ip"] = zone.ip.toString();
+        entry["host"] = zone.controllerName;
+        entry["setpoint"] = zone.setpoint;
+        entry["power"] = zone.powerOn;
+    }
 
-            // Update FreeSleep API
-            setFreeSleepTemperature(pillowTargetIP, "right", pillowSetpoint);
+    String response;
+    serializeJson(doc, response);
+    server.send(200, "application/json", response);
+}
 
-            // Update display
-            drawTemperatureUI();
+// Replace the zone layout: {"zones":[{"name":"Bed","ip":"192.168.1.100"},{"host":"pod-2"},...]}
+// The array length sets the zone count; fields left out keep the zone's current value.
+void handleAPISetZones() {
+    JsonDocument doc;
+    if (!server.hasArg("plain") || deserializeJson(doc, server.arg("plain")) || !doc["zones"].is<JsonArray>()) {
+        server.send(400, "application/json", "{\"error\":\"Expected a zones array\"}");
+        return;
+    }
 
-            // Send response
-            JsonDocument responseDoc;
-            responseDoc["success"] = true;
-            responseDoc["setpoint"] = pillowSetpoint;
+    JsonArray list = doc["zones"].as<JsonArray>();
+    int count = list.size();
+    if (count < 1 || count > MAX_ZONES) {
+        server.send(400, "application/json", "{\"error\":\"Zone count out of range\"}");
+        return;
+    }
 
-            String response;
-            serializeJson(responseDoc, response);
-            server.send(200, "application/json", response);
+    // Validate everything before touching the table. A zone bound by host is checked when it
+    // resolves; one left out keeps its current controller.
+    uint32_t proposed[MAX_ZONES] = {};
+    for (int i = 0; i < count; i++) {
+        JsonVariant entry = list[i];
+        IPAddress ip = i < zoneCount ? zoneTargetIP((FreeSleepZone)i) : IPAddress();
+        if (entry.containsKey("ip") && !ip.fromString(entry["ip"].as<String>())) {
+            server.send(400, "application/json", "{\"error\":\"Invalid IP address\"}");
             return;
         }
+        if (!entry.containsKey("host")) proposed[i] = (uint32_t)ip;
+        for (int other = 0; other < i; other++) {
+            if (proposed[i] && proposed[other] == proposed[i]) {
+                server.send(409, "application/json", "{\"error\":\"Two zones on one controller\"}");
+                return;
+            }
+        }
     }
 
-    server.send(400, "application/json", "{\"error\":\"Missing setpoint parameter\"}");
+    for (int i = 0; i < count; i++) {
+        FreeSleepZone zone = (FreeSleepZone)i;
+        JsonVariant entry = list[i];
+        const char* name = entry["name"] | "";
+        if (*name) strlcpy(zones[zone].name, name, sizeof(zones[zone].name));
+        if (entry.containsKey("host")) {
+            setZoneController(zone, entry["host"].as<String>());
+        } else if (entry.containsKey("ip")) {
+            zones[zone].ip.fromString(entry["ip"].as<String>());
+            saveZoneTargetIP(zone);
+            setZoneController(zone, "");
+        }
+    }
+
+    // Dropped zones take their unsent writes with them
+    for (int zone = count; zone < zoneCount; zone++) {
+        dropOutboxEntry((FreeSleepZone)zone);
+    }
+    zoneCount = count;
+    if (activeZone >= zoneCount) selectZone(ZONE_BED);
+    if (lastOtherZone >= zoneCount) lastOtherZone = ZONE_PILLOW;
+    saveZoneLayout();
+    saveOutbox();
+    bindZonesToControllers();
+    Serial.printf("Zone layout updated: %d zone(s)\n", zoneCount);
+
+    if (!inSettingsMenu) drawTemperatureUI();
+    server.send(200, "application/json", "{\"success\":true}");
 }
 
-void handleNotFound() {
-    server.send(404, "application/json", "{\"error\":\"Not found\"}");
+// Zone from the ?id= argument of the per-zone routes; answers 404 itself when there's no such zone
+bool zoneFromArg(FreeSleepZone& zone) {
+    int id = server.hasArg("id") ? server.arg("id").toInt() : -1;
+    if (id < 0 || id >= zoneCount) {
+        server.send(404, "application/json", "{\"error\":\"Unknown zone\"}");
+        return false;
+    }
+    zone = (FreeSleepZone)id;
+    return true;
 }
 
-void handleEncoderInput() {
-    // Route to appropriate handler based on current state
-    if (inSettingsMenu) {
-        if (currentSubMenu == SUBMENU_IP_EDITOR) {
-            handleEncoderInIPEditor();
-        } else if (currentSubMenu == SUBMENU_WIFI_SCAN) {
-            handleEncoderInWiFiScanner();
-        } else if (currentSubMenu == SUBMENU_WIFI_PASSWORD) {
-            handleEncoderInPasswordEntry();
-        } else {
-            handleEncoderInSettings();
-        }
+// {"dirtyPixels":true} keeps dirty-tile counts between benchmarks too. Off by default:
+// hashing the tiles is a full pass over every frame the dial pushes.
+void handleAPIRenderStatsConfig() {
+    JsonDocument doc;
+    if (!server.hasArg("plain") || deserializeJson(doc, server.arg("plain")) || !doc["dirtyPixels"].is<bool>()) {
+        server.send(400, "application/json", "{\"error\":\"Missing dirtyPixels parameter\"}");
         return;
     }
+    bool enable = doc["dirtyPixels"].as<bool>();
+    if (enable && !renderDirtyTracking) memset(frameTileHashes, 0, sizeof(frameTileHashes));
+    renderDirtyTracking = enable;
+    server.send(200, "application/json", renderDirtyTracking ? "{\"dirtyPixels\":true}" : "{\"dirtyPixels\":false}");
+}
 
-    // Default temperature control behavior
-    long newPosition = M5Dial.Encoder.read();
-
-    // Calculate difference from last update
-    long diff = newPosition - lastEncoderPosition;
+void handleAPIRenderStats() {
+    JsonDocument doc;
+    for (int i = 0; i < RENDER_SCREEN_COUNT; i++) {
+        const RenderStats& stats = renderStats[i];
+        JsonObject entry = doc[RENDER_SCREEN_NAMES[i]].to<JsonObject>();
+        entry["frames"] = stats.frames;
+        entry["avgRasterUs"] = stats.frames ? (uint32_t)(stats.rasterMicros / stats.frames) : 0;
+        entry["avgPushUs"] = stats.frames ? (uint32_t)(stats.pushMicros / stats.frames) : 0;
+        entry["maxFrameUs"] = stats.maxFrameMicros;
+        entry["pixelsPushed"] = stats.pixelsPushed;
+        entry["avgPrimitives"] = stats.frames ? (uint32_t)(stats.primitives / stats.frames) : 0;
+        entry["dirtyPixels"] = stats.dirtyPixels;
+    }
 
-    // Accumulate encoder movement until we hit a detent threshold
-    static long encoderAccumulator = 0;
+    String response;
+    serializeJson(doc, response);
+    server.send(200, "application/json", response);
+}
 
-    // Process any change
-    if (diff != 0) {
-        encoderAccumulator += diff;
-        lastEncoderPosition = newPosition;
-        recordActivity();
+// Per-controller request telemetry. Counters are written by the FreeSleep task; this is a snapshot.
+void handleAPIFreeSleepStats() {
+    JsonDocument doc;
+    JsonArray bounds = doc["bucketsMs"].to<JsonArray>();
+    for (uint16_t bound : LATENCY_BUCKET_MS) bounds.add(bound);
+
+    JsonArray controllers = doc["controllers"].to<JsonArray>();
+    for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS; i++) {
+        const FreeSleepConnection& conn = freeSleepConnections[i];
+        if (!conn.assigned) continue;
+
+        JsonObject controller = controllers.add<JsonObject>();
+        controller["ip"] = conn.ip.toString();
+        controller["connects"] = conn.connects;
+
+        for (int op = 0; op < FS_OP_COUNT; op++) {
+            const FreeSleepOpStats& stats = conn.ops[op];
+            if (stats.total.count == 0) continue;
+            JsonObject entry = controller[FS_OP_NAMES[op]].to<JsonObject>();
+
+            const LatencyHistogram* histograms[] = {&stats.connect, &stats.total};
+            const char* const names[] = {"connect", "total"};
+            for (int h = 0; h < 2; h++) {
+                const LatencyHistogram& histogram = *histograms[h];
+                JsonObject latency = entry[names[h]].to<JsonObject>();
+                latency["count"] = histogram.count;
+                latency["avgMs"] = histogram.count ? histogram.totalMicros / histogram.count / 1000.0f : 0;
+                latency["maxMs"] = histogram.maxMicros / 1000.0f;
+                JsonArray buckets = latency["buckets"].to<JsonArray>();
+                for (int b = 0; b < LATENCY_BUCKET_COUNT; b++) buckets.add(histogram.buckets[b]);
+            }
 
-        // Each physical detent is 4 encoder counts
+            JsonObject results = entry["results"].to<JsonObject>();
+            for (int r = 0; r < FS_RESULT_COUNT; r++) {
+                if (stats.results[r]) results[FS_RESULT_NAMES[r]] = stats.results[r];
+            }
+        }
+    }
+
+    String response;
+    serializeJson(doc, response);
+    server.send(200, "application/json", response);
+}
+
+// Start probing every controller in the background; the results are read with GET
+void handleAPIStartFreeSleepTest() {
+    if (!wifiConnected) {
+        server.send(503, "application/json", "{\"error\":\"WiFi not connected\"}");
+        return;
+    }
+    if (freeSleepDiagnosticsState == DIAGNOSTICS_RUNNING) {
+        server.send(202, "application/json", "{\"status\":\"running\"}");  // Join the run in progress
+        return;
+    }
+
+    FreeSleepDiagnostics& diagnostics = freeSleepDiagnostics;
+    diagnostics = {};
+    for (int i = 0; i < zoneCount; i++) {
+        FreeSleepZone zone = (FreeSleepZone)i;
+        diagnostics.ip[zone] = zoneTargetIP(zone);
+        strlcpy(diagnostics.host[zone], zoneControllerName(zone).c_str(), FREESLEEP_NAME_LEN);
+    }
+    diagnostics.startedAt = millis();
+
+    FreeSleepCommand command = {};
+    command.type = FS_CMD_DIAGNOSE;
+    freeSleepDiagnosticsState = DIAGNOSTICS_RUNNING;
+    if (!submitFreeSleepCommand(command)) {
+        freeSleepDiagnosticsState = DIAGNOSTICS_IDLE;
+        server.send(503, "application/json", "{\"error\":\"FreeSleep task busy\"}");
+        return;
+    }
+    server.send(202, "application/json", "{\"status\":\"running\"}");
+}
+
+// Report the last diagnostics run: each controller's phases, the WiFi link and recent percentiles
+void handleAPITestFreeSleep() {
+    FreeSleepDiagnostics& diagnostics = freeSleepDiagnostics;
+    DiagnosticsState state = freeSleepDiagnosticsState;
+    if (state == DIAGNOSTICS_IDLE || (state == DIAGNOSTICS_DONE && diagnostics.reported)) {
+        handleAPIStartFreeSleepTest();
+        return;
+    }
+    if (state != DIAGNOSTICS_DONE) {
+        JsonDocument doc;
+        doc["status"] = DIAGNOSTICS_STATE_NAMES[state];
+        if (state == DIAGNOSTICS_RUNNING) doc["elapsedMs"] = millis() - diagnostics.startedAt;
+        String response;
+        serializeJson(doc, response);
+        server.send(200, "application/json", response);
+        return;
+    }
+
+    JsonDocument doc;
+    doc["status"] = DIAGNOSTICS_STATE_NAMES[state];
+    doc["ageMs"] = millis() - diagnostics.finishedAt;
+    diagnostics.reported = true;  // The next GET starts a new run
+    JsonObject wifi = doc["wifi"].to<JsonObject>();
+    wifi["ssid"] = WiFi.SSID();
+    wifi["bssid"] = WiFi.BSSIDstr();
+    wifi["rssi"] = diagnostics.rssi;
+    wifi["channel"] = diagnostics.channel;
+    doc["side"] = activeSide();
+    doc["durationMs"] = diagnostics.durationMs;
+
+    JsonArray controllers = doc["controllers"].to<JsonArray>();
+    for (int zone = 0; zone < zoneCount; zone++) {
+        uint32_t ip = diagnostics.ip[zone];
+        if (!ip) continue;
+        bool seen = false;
+        for (int other = 0; other < zone; other++) seen |= diagnostics.ip[other] == ip;
+        if (seen) continue;  // Reported with the first zone on this controller
+
+        const FreeSleepProbe& probe = diagnostics.probes[zone];
+        JsonObject entry = controllers.add<JsonObject>();
+        entry["ip"] = IPAddress(ip).toString();
+        if (diagnostics.host[zone][0]) entry["host"] = diagnostics.host[zone];
+        JsonArray zoneNames = entry["zones"].to<JsonArray>();
+        for (int other = zone; other < zoneCount; other++) {
+            if (diagnostics.ip[other] == ip) zoneNames.add(zoneName((FreeSleepZone)other));
+        }
+        entry["httpCode"] = probe.httpCode;
+        entry["success"] = probe.httpCode == HTTP_CODE_OK;
+        entry["bodyBytes"] = probe.bodyBytes;
+
+        JsonObject phases = entry["phasesMs"].to<JsonObject>();
+        if (probe.dnsMicros) {
+            phases["dns"] = probe.dnsMicros / 1000.0f;
+            entry["resolvedIp"] = IPAddress(probe.resolvedIP).toString();
+        }
+        if (probe.connectMicros) phases["connect"] = probe.connectMicros / 1000.0f;
+        if (probe.sendMicros) phases["send"] = probe.sendMicros / 1000.0f;
+        if (probe.firstByteMicros) phases["firstByte"] = probe.firstByteMicros / 1000.0f;
+        phases["total"] = probe.totalMicros / 1000.0f;
+
+        // Percentiles of the traffic since the last stats reset, per operation
+        JsonObject recent = entry["recent"].to<JsonObject>();
+        for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS; i++) {
+            const FreeSleepConnection& conn = freeSleepConnections[i];
+            if (!conn.assigned || (uint32_t)conn.ip != ip) continue;
+            for (int op = 0; op < FS_OP_COUNT; op++) {
+                const LatencyHistogram& histogram = conn.ops[op].total;
+                if (histogram.count == 0) continue;
+                JsonObject latency = recent[FS_OP_NAMES[op]].to<JsonObject>();
+                latency["count"] = histogram.count;
+                latency["p50Ms"] = latencyPercentileMs(histogram, 50);
+                latency["p90Ms"] = latencyPercentileMs(histogram, 90);
+                latency["p99Ms"] = latencyPercentileMs(histogram, 99);
+            }
+        }
+    }
+
+    String response;
+    serializeJson(doc, response);
+    server.send(200, "application/json", response);
+}
+
+// Upper bound of the bucket the percentile falls in - the open last bucket (and any bound
+// above the slowest request seen) reports the max instead
+float latencyPercentileMs(const LatencyHistogram& histogram, int percentile) {
+    if (histogram.count == 0) return 0;
+    float maxMs = histogram.maxMicros / 1000.0f;
+    uint32_t rank = (histogram.count * percentile + 99) / 100;
+    uint32_t seen = 0;
+    for (int b = 0; b < LATENCY_BUCKET_COUNT - 1; b++) {
+        seen += histogram.buckets[b];
+        if (seen >= rank) return min((float)LATENCY_BUCKET_MS[b], maxMs);
+    }
+    return maxMs;
+}
+
+void handleAPIDiscovery() {
+    JsonDocument doc;
+    JsonArray controllers = doc["controllers"].to<JsonArray>();
+    for (int i = 0; i < FREESLEEP_DISCOVERY_MAX; i++) {
+        const DiscoveredController& found = discoveredControllers[i];
+        if (!found.valid) continue;
+        JsonObject entry = controllers.add<JsonObject>();
+        entry["host"] = found.name;
+        entry["ip"] = IPAddress(found.ip).toString();
+        entry["port"] = found.port;
+        entry["ttlMs"] = max(0L, (long)(found.expiresAt - millis()));
+    }
+
+    for (int i = 0; i < zoneCount; i++) {
+        FreeSleepZone zone = (FreeSleepZone)i;
+        JsonObject binding = doc[zoneKey(zone)].to<JsonObject>();
+        binding["host"] = zoneControllerName(zone);
+        binding["ip"] = zoneTargetIP(zone).toString();
+    }
+
+    String response;
+    serializeJson(doc, response);
+    server.send(200, "application/json", response);
+}
+
+void handleAPISyncStats() {
+    JsonDocument doc;
+    for (int zone = 0; zone < zoneCount; zone++) {
+        const FreeSleepSyncStats& stats = syncStats[zone];
+        JsonObject entry = doc[zoneKey(zone)].to<JsonObject>();
+        entry["unchanged"] = stats.unchanged;
+        entry["changed"] = stats.changed;
+        entry["failed"] = stats.failed;
+        entry["suppressed"] = stats.suppressed;
+        if (podTempF[zone]) entry["podTempF"] = podTempF[zone];
+        entry["fingerprint"] = zoneFingerprint[zone];
+    }
+
+    JsonObject queue = doc["outbox"].to<JsonObject>();
+    int depth = 0;
+    unsigned long oldestAge = 0;
+    for (int i = 0; i < zoneCount; i++) {
+        FreeSleepZone zone = (FreeSleepZone)i;
+        if (!outboxPending(zone)) continue;
+        const OutboxEntry& entry = outbox[zone];
+        depth++;
+        oldestAge = max(oldestAge, millis() - entry.queuedAt);
+
+        JsonObject item = queue[zoneKey(zone)].to<JsonObject>();
+        if (entry.hasTemperature) item["setpoint"] = entry.tempCelsius;
+        if (entry.hasPower) item["power"] = entry.powerOn;
+        item["ageMs"] = millis() - entry.queuedAt;
+        item["attempts"] = entry.attempts;
+        item["inFlight"] = entry.inFlight;
+        item["persisted"] = entry.persisted;
+    }
+    queue["depth"] = depth;
+    queue["oldestAgeMs"] = oldestAge;
+
+    doc["pollIntervalMs"] = freeSleepSyncInterval();
+    doc["latencyMs"] = syncLatencyMs;
+    doc["writeLatencyMs"] = writeLatencyMs;
+    JsonObject heap = doc["heap"].to<JsonObject>();
+    heap["free"] = ESP.getFreeHeap();
+    heap["allocations"] = freeSleepAllocations;
+    heap["lastRefreshAllocations"] = refreshAllocations;
+    heap["refreshesAllocating"] = refreshesAllocating;
+    doc["debounceMs"] = freeSleepDebounceWindow();
+
+    JsonObject push = doc["push"].to<JsonObject>();
+    push["live"] = (bool)freeSleepPushLive;
+    JsonArray streams = push["streams"].to<JsonArray>();
+    for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS; i++) {
+        const FreeSleepStream& stream = freeSleepStreams[i];
+        if (!stream.assigned) continue;
+        JsonObject entry = streams.add<JsonObject>();
+        entry["ip"] = stream.ip.toString();
+        entry["connected"] = stream.connected;
+        entry["connects"] = stream.connects;
+        entry["events"] = stream.events;
+    }
+
+    // Breaker state is owned by the FreeSleep task; this is a diagnostic snapshot
+    JsonArray controllers = doc["controllers"].to<JsonArray>();
+    for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS; i++) {
+        const FreeSleepConnection& conn = freeSleepConnections[i];
+        if (!conn.assigned) continue;
+        JsonObject entry = controllers.add<JsonObject>();
+        entry["ip"] = conn.ip.toString();
+        entry["breaker"] = BREAKER_STATE_NAMES[conn.breaker];
+        entry["failures"] = conn.failures;
+        entry["probeInMs"] = conn.breaker == BREAKER_OPEN ? max(0L, (long)(conn.probeAt - millis())) : 0;
+    }
+
+    String response;
+    serializeJson(doc, response);
+    server.send(200, "application/json", response);
+}
+
+// Queue every screen across themes, and the main screen across setpoints and units;
+// loop() renders them one case per pass and the results are read with GET
+void handleAPIStartRenderBench() {
+    if (renderBenchState != RENDER_BENCH_RUNNING) startRenderBench();  // Else join the run in progress
+    server.send(202, "application/json", "{\"status\":\"running\"}");
+}
+
+void startRenderBench() {
+    const float setpoints[RENDER_BENCH_SETPOINTS] = {TEMP_MIN, TEMP_DEFAULT, TEMP_MAX};
+    RenderBench& bench = renderBench;
+    bench = {};
+    int count = 0;
+    for (int theme = 0; theme < THEME_COUNT; theme++) {
+        for (int screen = 0; screen < RENDER_PARTIAL; screen++) {
+            bool mainScreen = screen == RENDER_TEMPERATURE;
+            for (int unit = 0; unit < (mainScreen ? 2 : 1); unit++) {
+                for (int sp = 0; sp < (mainScreen ? RENDER_BENCH_SETPOINTS : 1); sp++) {
+                    RenderBenchCase& benchCase = bench.cases[count++];
+                    benchCase.screen = (RenderScreen)screen;
+                    benchCase.theme = (ThemeId)theme;
+                    benchCase.fahrenheit = unit == 1;
+                    benchCase.setpoint = setpoints[sp];
+                }
+            }
+        }
+    }
+    bench.startedAt = millis();
+    memset(frameTileHashes, 0, sizeof(frameTileHashes));  // Hashes from before tracking was on are stale
+    renderBenchState = RENDER_BENCH_RUNNING;
+}
+
+// Render the next benchmark case
+void serviceRenderBench() {
+    if (renderBenchState != RENDER_BENCH_RUNNING) return;
+
+    RenderBench& bench = renderBench;
+    runRenderBenchCase(bench.cases[bench.next]);
+    if (++bench.next == RENDER_BENCH_CASES) {
+        bench.finishedAt = millis();
+        renderBenchState = RENDER_BENCH_DONE;
+        redrawCurrentScreen();  // Put the real screen back
+    }
+}
+
+// Render one case and fill in its results, putting back everything it touched before returning.
+// The case's last frame is left on the display.
+void runRenderBenchCase(RenderBenchCase& benchCase) {
+    float savedSetpoint = getActiveSetpoint();
+    bool savedFahrenheit = useFahrenheit;
+    bool savedAmbient = ambientFaceActive;
+    RenderStats savedStats = renderStats[benchCase.screen];
+
+    themeOverride = benchCase.theme;
+    useFahrenheit = benchCase.fahrenheit;
+    ambientFaceActive = false;
+    if (benchCase.screen == RENDER_TEMPERATURE) {
+        getActiveSetpoint() = benchCase.setpoint;
+    } else {
+        benchCase.setpoint = savedSetpoint;
+    }
+
+    renderStats[benchCase.screen] = {};
+    for (int frame = 0; frame < RENDER_BENCH_FRAMES; frame++) {
+        renderScreen(benchCase.screen);
+    }
+    const RenderStats& stats = renderStats[benchCase.screen];
+    benchCase.rasterMicros = stats.rasterMicros / RENDER_BENCH_FRAMES;
+    benchCase.pushMicros = stats.pushMicros / RENDER_BENCH_FRAMES;
+    benchCase.maxFrameMicros = stats.maxFrameMicros;
+    benchCase.pixelsPerFrame = stats.pixelsPushed / RENDER_BENCH_FRAMES;
+    benchCase.primitivesPerFrame = stats.primitives / RENDER_BENCH_FRAMES;
+    benchCase.dirtyPixels = stats.dirtyPixels;
+
+    themeOverride = -1;
+    useFahrenheit = savedFahrenheit;
+    getActiveSetpoint() = savedSetpoint;
+    ambientFaceActive = savedAmbient;
+    renderStats[benchCase.screen] = savedStats;
+}
+
+// Report the benchmark's progress, or every case once it is done
+void handleAPIRenderBench() {
+    const RenderBench& bench = renderBench;
+
+    JsonDocument doc;
+    doc["status"] = RENDER_BENCH_STATE_NAMES[renderBenchState];
+    if (renderBenchState == RENDER_BENCH_RUNNING) {
+        doc["elapsedMs"] = millis() - bench.startedAt;
+        doc["completed"] = bench.next;
+        doc["total"] = RENDER_BENCH_CASES;
+    } else if (renderBenchState == RENDER_BENCH_DONE) {
+        doc["ageMs"] = millis() - bench.finishedAt;
+        doc["durationMs"] = bench.finishedAt - bench.startedAt;
+        JsonArray cases = doc["cases"].to<JsonArray>();
+        for (const RenderBenchCase& benchCase : bench.cases) {
+            JsonObject entry = cases.add<JsonObject>();
+            entry["screen"] = RENDER_SCREEN_NAMES[benchCase.screen];
+            entry["theme"] = RENDER_THEME_NAMES[benchCase.theme];
+            entry["unit"] = benchCase.fahrenheit ? "F" : "C";
+            entry["setpoint"] = benchCase.setpoint;
+            entry["rasterUs"] = benchCase.rasterMicros;
+            entry["pushUs"] = benchCase.pushMicros;
+            entry["maxFrameUs"] = benchCase.maxFrameMicros;
+            entry["pixelsPerFrame"] = benchCase.pixelsPerFrame;
+            entry["primitivesPerFrame"] = benchCase.primitivesPerFrame;
+            entry["dirtyPixels"] = benchCase.dirtyPixels;
+        }
+    }
+
+    String response;
+    serializeJson(doc, response);
+    server.send(200, "application/json", response);
+}
+
+// Current frame as a 24-bit BMP, read back from the sprite.
+// Optional ?screen=<name>&theme=<0-2> renders that case first.
+void handleAPIScreenshot() {
+    bool rendered = false;
+    if (server.hasArg("screen")) {
+        String name = server.arg("screen");
+        for (int i = 0; i < RENDER_PARTIAL; i++) {
+            if (name == RENDER_SCREEN_NAMES[i]) {
+                bool savedAmbient = ambientFaceActive;
+                ambientFaceActive = false;
+                themeOverride = server.hasArg("theme") ? constrain(server.arg("theme").toInt(), 0, THEME_COUNT - 1) : -1;
+                renderScreen((RenderScreen)i);
+                themeOverride = -1;
+                ambientFaceActive = savedAmbient;
+                rendered = true;
+                break;
+            }
+        }
+    }
+
+    const uint32_t rowBytes = SCREEN_WIDTH * 3;  // 720 - already 4-byte aligned
+    const uint32_t imageBytes = rowBytes * SCREEN_HEIGHT;
+    const uint32_t fileBytes = 54 + imageBytes;
+
+    uint8_t header[54] = {'B', 'M'};
+    auto put32 = [&](int offset, uint32_t value) {
+        for (int i = 0; i < 4; i++) header[offset + i] = (value >> (8 * i)) & 0xFF;
+    };
+    put32(2, fileBytes);
+    put32(10, 54);            // Pixel data offset
+    put32(14, 40);            // BITMAPINFOHEADER size
+    put32(18, SCREEN_WIDTH);
+    put32(22, SCREEN_HEIGHT);
+    header[26] = 1;           // Planes
+    header[28] = 24;          // Bits per pixel
+    put32(34, imageBytes);
+
+    server.setContentLength(fileBytes);
+    server.send(200, "image/bmp", "");
+    server.sendContent((const char*)header, sizeof(header));
+
+    // BMP rows are bottom-up, BGR
+    uint8_t row[SCREEN_WIDTH * 3];
+    for (int y = SCREEN_HEIGHT - 1; y >= 0; y--) {
+        for (int x = 0; x < SCREEN_WIDTH; x++) {
+            uint16_t c = sprite.readPixel(x, y);
+            row[x * 3 + 0] = (c << 3) & 0xF8;
+            row[x * 3 + 1] = (c >> 3) & 0xFC;
+            row[x * 3 + 2] = (c >> 8) & 0xF8;
+        }
+        server.sendContent((const char*)row, rowBytes);
+    }
+
+    if (rendered) {
+        redrawCurrentScreen();
+    }
+}
+
+void handleNotFound() {
+    server.send(404, "application/json", "{\"error\":\"Not found\"}");
+}
+
+void handleEncoderInput() {
+    // Route to appropriate handler based on current state
+    if (inSettingsMenu) {
+        if (currentSubMenu == SUBMENU_IP_EDITOR) {
+            handleEncoderInIPEditor();
+        } else if (currentSubMenu == SUBMENU_WIFI_SCAN) {
+            handleEncoderInWiFiScanner();
+        } else if (currentSubMenu == SUBMENU_WIFI_PASSWORD) {
+            handleEncoderInPasswordEntry();
+        } else {
+            handleEncoderInSettings();
+        }
+        return;
+    }
+
+    // Default temperature control behavior
+    long newPosition = M5Dial.Encoder.read();
+
+    // Calculate difference from last update
+    long diff = newPosition - lastEncoderPosition;
+
+    // Accumulate encoder movement until we hit a detent threshold
+    static long encoderAccumulator = 0;
+
+    // Process any change
+    if (diff != 0) {
+        encoderAccumulator += diff;
+        lastEncoderPosition = newPosition;
+        recordActivity();
+
+        // Each physical detent is 4 encoder counts
         // Change temperature when we accumulate enough for one step
         if (abs(encoderAccumulator) >= 4) {
             int steps = encoderAccumulator / 4;
@@ -770,20 +2017,15 @@ void handleEncoderInput() {
                 activeSetpoint = newTemp;
                 if (useFahrenheit) {
                     Serial.printf("Encoder: %s Temperature: %.0f°F\n",
-                                 pillowModeActive ? "Pillow" : "Bed", celsiusToFahrenheit(activeSetpoint));
+                                 zoneName(activeZone), celsiusToFahrenheit(activeSetpoint));
                 } else {
                     Serial.printf("Encoder: %s Temperature: %.1f°C\n",
-                                 pillowModeActive ? "Pillow" : "Bed", activeSetpoint);
+                                 zoneName(activeZone), activeSetpoint);
                 }
                 drawTemperatureUI();
 
                 // Schedule debounced FreeSleep API update
-                // Reset failfast on user interaction - they want to try again
-                skipUserUpdates = false;
-                consecutiveFailures = 0;
-                currentSyncInterval = FREESLEEP_SYNC_INTERVAL_MS;
-                lastSetpointChangeTime = millis();
-                pendingFreeSleepUpdate = true;
+                scheduleFreeSleepUpdate();
             }
         }
     }
@@ -791,18 +2033,12 @@ void handleEncoderInput() {
     // Handle encoder button press (reset to default)
     if (M5Dial.BtnA.wasPressed()) {
         getActiveSetpoint() = TEMP_DEFAULT;
-        Serial.printf("Reset %s to default: %.1f°C\n",
-                     pillowModeActive ? "Pillow" : "Bed", TEMP_DEFAULT);
+        Serial.printf("Reset %s to default: %.1f°C\n", zoneName(activeZone), TEMP_DEFAULT);
         recordActivity();
         drawTemperatureUI();
 
         // Schedule debounced FreeSleep API update
-        // Reset failfast on user interaction - they want to try again
-        skipUserUpdates = false;
-        consecutiveFailures = 0;
-        currentSyncInterval = FREESLEEP_SYNC_INTERVAL_MS;
-        lastSetpointChangeTime = millis();
-        pendingFreeSleepUpdate = true;
+        scheduleFreeSleepUpdate();
     }
 }
 
@@ -861,11 +2097,12 @@ void handleTouchInput() {
         const int leftButtonX = 50;
         const int rightButtonX = SCREEN_WIDTH - 50;
 
-        // Check if touch is on pillow button (left)
-        if (abs(touch.x - leftButtonX) < buttonSize/2 && abs(touch.y - buttonY) < buttonSize/2) {
-            if (!pillowModeActive) {
-                pillowModeActive = true;
-                Serial.println("Switched to Pillow mode");
+        // Check if touch is on the other-zone button (left)
+        // From the bed it returns to the last other zone; from there it steps through the rest
+        if (zoneCount > 1 && abs(touch.x - leftButtonX) < buttonSize/2 && abs(touch.y - buttonY) < buttonSize/2) {
+            FreeSleepZone next = (activeZone == ZONE_BED) ? lastOtherZone : activeZone % (zoneCount - 1) + 1;
+            if (next != activeZone) {
+                selectZone(next);
                 drawTemperatureUI();
             }
             return;
@@ -873,9 +2110,8 @@ void handleTouchInput() {
 
         // Check if touch is on bed button (right)
         if (abs(touch.x - rightButtonX) < buttonSize/2 && abs(touch.y - buttonY) < buttonSize/2) {
-            if (pillowModeActive) {
-                pillowModeActive = false;
-                Serial.println("Switched to Bed mode");
+            if (activeZone != ZONE_BED) {
+                selectZone(ZONE_BED);
                 drawTemperatureUI();
             }
             return;
@@ -919,17 +2155,11 @@ void handleTouchInput() {
             // Round to nearest 0.5°C increment
             getActiveSetpoint() = round(newTemp * 2.0) / 2.0;
 
-            Serial.printf("Touch set %s temperature: %.1f°C\n",
-                         pillowModeActive ? "Pillow" : "Bed", getActiveSetpoint());
+            Serial.printf("Touch set %s temperature: %.1f°C\n", zoneName(activeZone), getActiveSetpoint());
             drawTemperatureUI();
 
             // Schedule debounced FreeSleep API update
-            // Reset failfast on user interaction - they want to try again
-            skipUserUpdates = false;
-            consecutiveFailures = 0;
-            currentSyncInterval = FREESLEEP_SYNC_INTERVAL_MS;
-            lastSetpointChangeTime = millis();
-            pendingFreeSleepUpdate = true;
+            scheduleFreeSleepUpdate();
         }
         // Note: Center touch is now handled via duration detection above
     }
@@ -940,9 +2170,13 @@ void handleTouchInput() {
         unsigned long now = millis();
         unsigned long touchDuration = now - centerTouchStartTime;
 
+        // Actions that don't redraw the screen must erase the progress ring
+        bool ringShown = pressRingDrawnAngle > 0;
+
         // Debounce: ignore taps that come too quickly after the last one
         if (now - lastCenterTapTime < TAP_DEBOUNCE_MS) {
             Serial.println("Tap ignored (debounce)");
+            if (ringShown) drawTemperatureUI();
             return;
         }
         lastCenterTapTime = now;
@@ -961,6 +2195,7 @@ void handleTouchInput() {
                 Serial.println("Quick tap - dimming");
             }
             updateBrightness();
+            if (ringShown) drawTemperatureUI();
         } else if (touchDuration < POWER_MAX_MS) {
             // 200-1000ms: Toggle power for active mode (bed or pillow)
             Serial.printf("Power toggle tap (%lums)\n", touchDuration);
@@ -971,37 +2206,115 @@ void handleTouchInput() {
             Serial.printf("Night mode override: %s (%lums)\n", nightModeOverride ? "ON" : "OFF", touchDuration);
             drawTemperatureUI();
         } else {
-            // > 3000ms: Open settings menu
-            Serial.printf("Long hold - opening menu (%lums)\n", touchDuration);
-            inSettingsMenu = true;
-            currentMenuItem = MENU_WIFI_SETTINGS;
-            currentSubMenu = SUBMENU_NONE;
-            drawSettingsMenu();
+            // > 3000ms: Open settings menu (normally already opened by updatePressRing)
+            openSettingsFromHold(touchDuration);
         }
     }
 }
 
+// Grow the press-progress ring while the center is held.
+// Only the newly covered segment is drawn each frame, straight to the display;
+// the whole ring is repainted only when a threshold changes its color.
+void updatePressRing() {
+    if (!centerTouchActive || isDimmed) return;
+
+    unsigned long now = millis();
+    unsigned long held = now - centerTouchStartTime;
+    if (held < PRESS_RING_DELAY_MS || now - lastPressRingFrame < PRESS_RING_FRAME_MS) return;
+    lastPressRingFrame = now;
+
+    // Ring complete - open settings now instead of waiting for release
+    if (held >= NIGHT_MODE_MAX_MS) {
+        centerTouchActive = false;
+        lastCenterTapTime = now;
+        openSettingsFromHold(held);
+        return;
+    }
+
+    // Color shows which action a release would trigger right now
+    const Theme& theme = activeTheme();
+    uint16_t color;
+    if (held < TAP_MIN_MS) {
+        color = theme.dimText;   // Wake/dim
+    } else if (held < POWER_MAX_MS) {
+        color = theme.setpoint;  // Power toggle
+    } else {
+        color = theme.arcWarm;   // Night mode toggle
+    }
+
+    int angle = held * 360 / NIGHT_MODE_MAX_MS;
+
+    if (pressRingDrawnAngle == 0) {
+        // First frame (or the screen was redrawn underneath us) - lay down the track
+        // with notches where the thresholds are
+        fillPressRingArc(0, 360, theme.arcBg);
+        fillPressRingArc(TAP_MIN_MS * 360 / NIGHT_MODE_MAX_MS, TAP_MIN_MS * 360 / NIGHT_MODE_MAX_MS + 2, theme.text);
+        fillPressRingArc(POWER_MAX_MS * 360 / NIGHT_MODE_MAX_MS, POWER_MAX_MS * 360 / NIGHT_MODE_MAX_MS + 2, theme.text);
+    }
+
+    int fromAngle = (pressRingDrawnAngle == 0 || color != pressRingColor) ? 0 : pressRingDrawnAngle;
+    if (angle > fromAngle) {
+        fillPressRingArc(fromAngle, angle, color);
+    }
+    pressRingDrawnAngle = max(angle, 1);
+    pressRingColor = color;
+}
+
+// Fill part of the press ring; angles are degrees clockwise from 12 o'clock
+void fillPressRingArc(int fromAngle, int toAngle, uint16_t color) {
+    // Screen angles start at 3 o'clock - split the segment if it crosses 0°
+    int start = (fromAngle + 270) % 360;
+    int end = start + (toAngle - fromAngle);
+    const int innerRadius = PRESS_RING_RADIUS - PRESS_RING_THICKNESS;
+    unsigned long pushStart = micros();
+
+    if (end > 360) {
+        M5Dial.Display.fillArc(centerX, centerY, innerRadius, PRESS_RING_RADIUS, start, 360, color);
+        M5Dial.Display.fillArc(centerX, centerY, innerRadius, PRESS_RING_RADIUS, 0, end - 360, color);
+    } else {
+        M5Dial.Display.fillArc(centerX, centerY, innerRadius, PRESS_RING_RADIUS, start, end, color);
+    }
+
+    // Ring area covered by this segment
+    float ringArea = PI * (PRESS_RING_RADIUS * PRESS_RING_RADIUS - innerRadius * innerRadius);
+    recordPartialPush(pushStart, (uint32_t)(ringArea * (toAngle - fromAngle) / 360));
+}
+
+void openSettingsFromHold(unsigned long holdDuration) {
+    Serial.printf("Long hold - opening menu (%lums)\n", holdDuration);
+    pressRingDrawnAngle = 0;
+    inSettingsMenu = true;
+    currentMenuRow = 0;
+    currentSubMenu = SUBMENU_NONE;
+    drawSettingsMenu();
+}
+
 void drawTemperatureUI() {
-    // Determine if we're in night mode
-    bool nightMode = isNightTime();
+    // While dimmed, state changes only update the ambient face
+    if (ambientFaceActive) {
+        drawAmbientFace();
+        return;
+    }
 
-    // Select colors based on mode
-    uint16_t bgColor = nightMode ? COLOR_NIGHT_BACKGROUND : COLOR_BACKGROUND;
-    uint16_t arcBgColor = nightMode ? COLOR_NIGHT_ARC_BG : COLOR_ARC_BG;
-    uint16_t textColor = nightMode ? COLOR_NIGHT_TEXT : COLOR_TEXT;
-    uint16_t setpointColor = nightMode ? COLOR_NIGHT_SETPOINT : COLOR_SETPOINT;
-    uint16_t minColor = nightMode ? COLOR_NIGHT_ARC_COLD : COLOR_ARC_COLD;
-    uint16_t maxColor = nightMode ? COLOR_NIGHT_ARC_HOT : COLOR_ARC_HOT;
+    unsigned long renderStart = micros();
+
+    // Colors come from the active theme's precomputed table
+    const Theme& theme = activeTheme();
+    uint16_t bgColor = theme.background;
+    uint16_t arcBgColor = theme.arcBg;
+    uint16_t textColor = theme.text;
+    uint16_t setpointColor = theme.setpoint;
+    uint16_t minColor = theme.arcCold;
+    uint16_t maxColor = theme.arcHot;
 
     // Clear sprite
     sprite.fillSprite(bgColor);
+    pressRingDrawnAngle = 0;  // Full redraw wipes the press ring - repaint it next frame
 
-    // Arc range from 8:30 o'clock to 3:30 o'clock going clockwise
-    // Screen coords: 0°=3 o'clock, 90°=6 o'clock, 180°=9 o'clock, 270°=12 o'clock
-    // Fine-tuned to 165°
-    const int startAngle = 165;   // 8:30 o'clock position (fine-tuned)
-    const int endAngle = 375;     // 3:30 o'clock position (wraps around 360°)
-    const int totalArcDegrees = endAngle - startAngle;  // 210 degrees
+    // Arc range from 8:30 o'clock to 3:30 o'clock going clockwise (see theme.h)
+    const int startAngle = ARC_START_ANGLE;
+    const int endAngle = ARC_END_ANGLE;
+    const int totalArcDegrees = ARC_TOTAL_DEGREES;
 
     // Draw tick markers first (before the arc)
     for (float temp = TEMP_MIN; temp <= TEMP_MAX; temp += 1.0) {
@@ -1038,7 +2351,7 @@ void drawTemperatureUI() {
     }
 
     // Draw background arc (full range)
-    for (int angle = startAngle; angle <= endAngle; angle += 2) {
+    for (int angle = startAngle; angle <= endAngle; angle += ARC_ANGLE_STEP) {
         float rad = (angle % 360) * PI / 180.0;
         int x1 = centerX + cos(rad) * (arcRadius - arcThickness);
         int y1 = centerY + sin(rad) * (arcRadius - arcThickness);
@@ -1051,18 +2364,11 @@ void drawTemperatureUI() {
     float activeTemp = getActiveSetpoint();
     float tempPercent = (activeTemp - TEMP_MIN) / (TEMP_MAX - TEMP_MIN);
     int currentAngle = startAngle + (int)(tempPercent * totalArcDegrees);
+    currentAngle = min(currentAngle, endAngle);  // The gradient table ends with the arc
 
-    for (int angle = startAngle; angle <= currentAngle; angle += 2) {
-        // Calculate color gradient based on position in arc
-        float arcPercent = (float)(angle - startAngle) / (float)totalArcDegrees;
-        uint16_t color;
-        if (nightMode) {
-            // Red gradient for night mode
-            color = getTemperatureColorNight(TEMP_MIN + arcPercent * (TEMP_MAX - TEMP_MIN));
-        } else {
-            // Normal color gradient for day mode
-            color = getTemperatureColor(TEMP_MIN + arcPercent * (TEMP_MAX - TEMP_MIN));
-        }
+    for (int angle = startAngle; angle <= currentAngle; angle += ARC_ANGLE_STEP) {
+        // Gradient color for this position, generated at compile time
+        uint16_t color = theme.arcGradient[(angle - startAngle) / ARC_ANGLE_STEP];
 
         float rad = (angle % 360) * PI / 180.0;
         int x1 = centerX + cos(rad) * (arcRadius - arcThickness);
@@ -1072,32 +2378,32 @@ void drawTemperatureUI() {
         sprite.drawLine(x1, y1, x2, y2, color);
     }
 
-    // Draw bed setpoint indicator (outer marker)
-    float bedTempPercent = (bedSetpoint - TEMP_MIN) / (TEMP_MAX - TEMP_MIN);
-    int bedAngle = startAngle + (int)(bedTempPercent * totalArcDegrees);
-    float bedRad = (bedAngle % 360) * PI / 180.0;
-    int bedIndicatorX = centerX + cos(bedRad) * (arcRadius + 8);
-    int bedIndicatorY = centerY + sin(bedRad) * (arcRadius + 8);
-    sprite.fillCircle(bedIndicatorX, bedIndicatorY, 5, pillowModeActive ? arcBgColor : setpointColor);
-    if (pillowModeActive) {
-        // Draw outline when inactive
-        sprite.drawCircle(bedIndicatorX, bedIndicatorY, 5, setpointColor);
-    }
-
-    // Draw pillow setpoint indicator (inner marker)
-    float pillowTempPercent = (pillowSetpoint - TEMP_MIN) / (TEMP_MAX - TEMP_MIN);
-    int pillowAngle = startAngle + (int)(pillowTempPercent * totalArcDegrees);
-    float pillowRad = (pillowAngle % 360) * PI / 180.0;
-    int pillowIndicatorX = centerX + cos(pillowRad) * (arcRadius - arcThickness - 8);
-    int pillowIndicatorY = centerY + sin(pillowRad) * (arcRadius - arcThickness - 8);
-    sprite.fillCircle(pillowIndicatorX, pillowIndicatorY, 5, pillowModeActive ? setpointColor : arcBgColor);
-    if (!pillowModeActive) {
-        // Draw outline when inactive
-        sprite.drawCircle(pillowIndicatorX, pillowIndicatorY, 5, setpointColor);
+    // Draw a setpoint indicator per zone - the bed outside the arc, the others inside it
+    for (int zone = 0; zone < zoneCount; zone++) {
+        float zoneTempPercent = (zones[zone].setpoint - TEMP_MIN) / (TEMP_MAX - TEMP_MIN);
+        int zoneAngle = constrain(startAngle + (int)(zoneTempPercent * totalArcDegrees), startAngle, endAngle);
+        float zoneRad = (zoneAngle % 360) * PI / 180.0;
+        int markerRadius = (zone == ZONE_BED) ? arcRadius + 8 : arcRadius - arcThickness - 8;
+        int indicatorX = centerX + cos(zoneRad) * markerRadius;
+        int indicatorY = centerY + sin(zoneRad) * markerRadius;
+        bool active = zone == activeZone;
+        sprite.fillCircle(indicatorX, indicatorY, 5, active ? setpointColor : arcBgColor);
+        if (!active) {
+            // Draw outline when inactive
+            sprite.drawCircle(indicatorX, indicatorY, 5, setpointColor);
+        }
     }
 
     // Check if active mode is powered off
-    bool activePowerOn = pillowModeActive ? pillowPowerOn : bedPowerOn;
+    bool activePowerOn = zones[activeZone].powerOn;
+
+    // With more than bed and pillow, name the zone being adjusted
+    if (zoneCount > 2) {
+        sprite.setFont(&fonts::FreeSans9pt7b);
+        sprite.setTextColor(setpointColor);
+        sprite.setTextDatum(middle_center);
+        sprite.drawString(zones[activeZone].name, centerX, centerY - 50);
+    }
 
     // Draw temperature value in center with large modern font
     sprite.setTextColor(activePowerOn ? textColor : arcBgColor);  // Dim if powered off
@@ -1125,7 +2431,7 @@ void drawTemperatureUI() {
     // Draw "OFF" indicator if power is off
     if (!activePowerOn) {
         sprite.setFont(&fonts::FreeSansBold12pt7b);
-        sprite.setTextColor(nightMode ? COLOR_NIGHT_ARC_HOT : COLOR_ARC_HOT);  // Red/bright for visibility
+        sprite.setTextColor(theme.arcHot);  // Red/bright for visibility
         sprite.drawString("OFF", centerX, centerY + 55);
     }
 
@@ -1172,27 +2478,38 @@ void drawTemperatureUI() {
         sprite.drawString("No WiFi", centerX, SCREEN_HEIGHT - 15);
     }
 
-    // Draw pillow button on the left
+    // Draw the other-zone button on the left (pillow, or the next zone's number)
     const int buttonY = SCREEN_HEIGHT - 55;  // Position above time/IP
     const int buttonSize = 40;  // Much larger for easier tapping
     const int leftButtonX = 50;
     const int rightButtonX = SCREEN_WIDTH - 50;
 
     // Determine button colors based on active state
-    uint16_t pillowBgColor = pillowModeActive ? setpointColor : arcBgColor;
-    uint16_t pillowIconColor = pillowModeActive ? bgColor : textColor;
-    uint16_t bedBgColor = pillowModeActive ? arcBgColor : setpointColor;
-    uint16_t bedIconColor = pillowModeActive ? textColor : bgColor;
-
-    // Pillow button (left)
-    sprite.fillRoundRect(leftButtonX - buttonSize/2, buttonY - buttonSize/2, buttonSize, buttonSize, 6, pillowBgColor);
-    // Draw pillow icon (fluffy pillow shape with pinched ends)
-    // Main pillow body - puffy center
-    sprite.fillRoundRect(leftButtonX - 10, buttonY - 6, 20, 12, 5, pillowIconColor);
-    // Pinched left end
-    sprite.fillRoundRect(leftButtonX - 14, buttonY - 3, 6, 6, 2, pillowIconColor);
-    // Pinched right end
-    sprite.fillRoundRect(leftButtonX + 8, buttonY - 3, 6, 6, 2, pillowIconColor);
+    bool bedActive = activeZone == ZONE_BED;
+    uint16_t otherBgColor = bedActive ? arcBgColor : setpointColor;
+    uint16_t otherIconColor = bedActive ? textColor : bgColor;
+    uint16_t bedBgColor = bedActive ? setpointColor : arcBgColor;
+    uint16_t bedIconColor = bedActive ? bgColor : textColor;
+
+    // Other-zone button (left) - hidden on a single-zone dial
+    if (zoneCount > 1) {
+        sprite.fillRoundRect(leftButtonX - buttonSize/2, buttonY - buttonSize/2, buttonSize, buttonSize, 6, otherBgColor);
+        FreeSleepZone otherZone = bedActive ? lastOtherZone : activeZone;
+        if (otherZone == ZONE_PILLOW) {
+            // Draw pillow icon (fluffy pillow shape with pinched ends)
+            // Main pillow body - puffy center
+            sprite.fillRoundRect(leftButtonX - 10, buttonY - 6, 20, 12, 5, otherIconColor);
+            // Pinched left end
+            sprite.fillRoundRect(leftButtonX - 14, buttonY - 3, 6, 6, 2, otherIconColor);
+            // Pinched right end
+            sprite.fillRoundRect(leftButtonX + 8, buttonY - 3, 6, 6, 2, otherIconColor);
+        } else {
+            sprite.setFont(&fonts::FreeSansBold12pt7b);
+            sprite.setTextColor(otherIconColor);
+            sprite.setTextDatum(middle_center);
+            sprite.drawString(String(otherZone + 1).c_str(), leftButtonX, buttonY);
+        }
+    }
 
     // Bed button (right)
     sprite.fillRoundRect(rightButtonX - buttonSize/2, buttonY - buttonSize/2, buttonSize, buttonSize, 6, bedBgColor);
@@ -1204,21 +2521,22 @@ void drawTemperatureUI() {
     sprite.fillCircle(rightButtonX + 6, buttonY - 4, 3, bedIconColor);  // pillow/head
 
     // Push sprite to display (eliminates flicker)
-    sprite.pushSprite(0, 0);
+    pushFrame(RENDER_TEMPERATURE, renderStart);
 }
 
 void drawSettingsMenu() {
-    // Determine if we're in night mode
-    bool nightMode = isNightTime();
+    unsigned long renderStart = micros();
 
-    // Select colors based on mode
-    uint16_t bgColor = nightMode ? COLOR_NIGHT_BACKGROUND : COLOR_BACKGROUND;
-    uint16_t textColor = nightMode ? COLOR_NIGHT_TEXT : COLOR_TEXT;
-    uint16_t accentColor = nightMode ? COLOR_NIGHT_SETPOINT : COLOR_SETPOINT;
-    uint16_t dimTextColor = nightMode ? 0x4000 : 0x4208;  // Dimmed text for non-active items
+    // Select colors from the active theme
+    const Theme& theme = activeTheme();
+    uint16_t bgColor = theme.background;
+    uint16_t textColor = theme.text;
+    uint16_t accentColor = theme.setpoint;
+    uint16_t dimTextColor = theme.dimText;  // Dimmed text for non-active items
 
     // Clear sprite
     sprite.fillSprite(bgColor);
+    marquee.active = false;  // Re-armed below if the active label overflows
 
     // Draw title
     sprite.setTextColor(accentColor);
@@ -1233,34 +2551,31 @@ void drawSettingsMenu() {
 
     // Draw menu items in carousel style
     for (int i = -2; i <= 2; i++) {
-        int itemIndex = ((int)currentMenuItem + i + MENU_COUNT) % MENU_COUNT;
+        int rowCount = menuRowCount();
+        int row = (currentMenuRow + i + rowCount * 2) % rowCount;
         int yPos = centerY_menu + (i * itemSpacing);
 
         // Skip items that are off-screen
         if (yPos < 50 || yPos > SCREEN_HEIGHT - 30) continue;
 
-        MenuItem item = (MenuItem)itemIndex;
-        String itemName = getMenuItemName(item);
+        FreeSleepZone rowZone;
+        MenuItem item = menuRowItem(row, rowZone);
+        String itemName = getMenuItemName(item, rowZone);
 
         // Active item (i == 0) is centered, larger, and bold
         if (i == 0) {
-            sprite.setFont(&fonts::FreeSansBold12pt7b);
-            sprite.setTextColor(accentColor);
-            sprite.setTextDatum(middle_center);
-            sprite.drawString(itemName.c_str(), centerX, yPos);
+            drawMarqueeLabel(itemName.c_str(), &fonts::FreeSansBold12pt7b, accentColor, bgColor, centerX, yPos);
 
             // Draw current value below for active item
             sprite.setTextColor(textColor);
+            sprite.setTextDatum(middle_center);
             String value = "";
             switch (item) {
                 case MENU_WIFI_SETTINGS:
                     value = wifiConnected ? WiFi.localIP().toString() : "Not connected";
                     break;
-                case MENU_BED_IP:
-                    value = bedTargetIP.toString();
-                    break;
-                case MENU_PILLOW_IP:
-                    value = pillowTargetIP.toString();
+                case MENU_ZONE_IP:
+                    value = zones[rowZone].ip.toString();
                     break;
                 case MENU_BED_SIDE:
                     value = bedSideRight ? "Right" : "Left";
@@ -1272,7 +2587,7 @@ void drawSettingsMenu() {
                     value = nightModeOverride ? "Override ON" : "Auto";
                     break;
                 case MENU_TEMPERATURE_MODE:
-                    value = pillowModeActive ? "Pillow" : "Bed";
+                    value = zoneName(activeZone);
                     break;
                 default:
                     break;
@@ -1287,15 +2602,8 @@ void drawSettingsMenu() {
             sprite.drawString("<", centerX + 100, yPos);
         } else {
             // Non-active items are smaller and dimmed
-            sprite.setFont(&fonts::FreeSans9pt7b);
-            sprite.setTextColor(dimTextColor);
-            sprite.setTextDatum(middle_center);
-
-            // Scale text based on distance from center
-            int alpha = 255 - abs(i) * 80;
-            if (alpha < 80) alpha = 80;
-
-            sprite.drawString(itemName.c_str(), centerX, yPos);
+            drawCachedLabel(itemName.c_str(), &fonts::FreeSans9pt7b, dimTextColor, bgColor,
+                            centerX, yPos, labelWidthAt(yPos));
         }
     }
 
@@ -1306,112 +2614,386 @@ void drawSettingsMenu() {
     sprite.drawString("Turn to navigate | Click to select | Tap to exit", centerX, SCREEN_HEIGHT - 10);
 
     // Push sprite to display
-    sprite.pushSprite(0, 0);
+    pushFrame(RENDER_SETTINGS, renderStart);
 }
 
-void updateClockDisplay() {
-    // Determine if we're in night mode
-    bool nightMode = isNightTime();
-    uint16_t bgColor = nightMode ? COLOR_NIGHT_BACKGROUND : COLOR_BACKGROUND;
-    uint16_t textColor = nightMode ? COLOR_NIGHT_TEXT : COLOR_TEXT;
+// Look up the pre-rendered strip for a label, rendering it on a miss.
+// The key covers string, font and colours so day/night variants get separate entries.
+TextLayout& getTextLayout(const char* text, const lgfx::IFont* font, uint16_t fgColor, uint16_t bgColor) {
+    // FNV-1a over the string, with font and colours folded in
+    uint32_t hash = 2166136261u;
+    for (const char* p = text; *p; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    hash ^= (uint32_t)(uintptr_t)font ^ ((uint32_t)fgColor << 16) ^ bgColor;
+
+    textCacheClock++;
+    TextLayout* victim = &textCache[0];
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++) {
+        TextLayout& entry = textCache[i];
+        if (entry.valid && entry.hash == hash && entry.font == font &&
+            entry.fgColor == fgColor && entry.bgColor == bgColor && entry.text == text) {
+            entry.lastUsed = textCacheClock;
+            return entry;
+        }
+        // Evict an empty slot first, otherwise the least recently used one
+        unsigned long age = entry.valid ? entry.lastUsed : 0;
+        unsigned long victimAge = victim->valid ? victim->lastUsed : 0;
+        if (age < victimAge) {
+            victim = &entry;
+        }
+    }
 
-    // Create a small sprite just for the time area (centered, about 80 pixels wide, 15 pixels tall to cover ghost text)
-    LGFX_Sprite timeSprite(&M5Dial.Display);
-    const int timeWidth = 80;
-    const int timeHeight = 15;
-    const int timeX = centerX - timeWidth / 2;
-    const int timeY = SCREEN_HEIGHT - 30 - (timeHeight / 2);  // Center around Y position used in drawTemperatureUI
+    // Miss - measure once and rasterise into the strip
+    TextLayout& entry = *victim;
+    entry.strip.deleteSprite();
+    entry.strip.setPsram(true);
+    entry.strip.setFont(font);
+    entry.hash = hash;
+    entry.text = text;
+    entry.font = font;
+    entry.fgColor = fgColor;
+    entry.bgColor = bgColor;
+    entry.width = entry.strip.textWidth(text);
+    entry.height = entry.strip.fontHeight();
+    entry.lastUsed = textCacheClock;
+    entry.valid = entry.strip.createSprite(max(entry.width, 1), entry.height) != nullptr;
+
+    if (entry.valid) {
+        entry.strip.fillSprite(bgColor);
+        entry.strip.setTextColor(fgColor);
+        entry.strip.setTextDatum(middle_left);
+        entry.strip.drawString(text, 0, entry.height / 2);
+    }
 
-    timeSprite.createSprite(timeWidth, timeHeight);
-    timeSprite.fillSprite(bgColor);
+    return entry;
+}
 
-    // Draw time to sprite
-    if (timeInitialized) {
-        struct tm timeinfo;
-        if (getLocalTime(&timeinfo)) {
-            timeSprite.setFont(&fonts::Font0);
-            timeSprite.setTextColor(textColor);
-            timeSprite.setTextDatum(middle_center);
+// Draw a label centred at (x, y) from the layout cache, clipped to maxWidth
+void drawCachedLabel(const char* text, const lgfx::IFont* font, uint16_t fgColor, uint16_t bgColor,
+                     int x, int y, int maxWidth) {
+    TextLayout& layout = getTextLayout(text, font, fgColor, bgColor);
 
-            char timeStr[10];
-            snprintf(timeStr, sizeof(timeStr), "%02d:%02d:%02d",
-                     timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
-            // Draw at vertical center of sprite
-            timeSprite.drawString(timeStr, timeWidth / 2, timeHeight / 2);
-        }
+    if (!layout.valid) {
+        // Out of memory for the strip - fall back to drawing directly
+        sprite.setFont(font);
+        sprite.setTextColor(fgColor);
+        sprite.setTextDatum(middle_center);
+        sprite.drawString(text, x, y);
+        return;
     }
 
-    // Push only the time sprite to the specific location
-    timeSprite.pushSprite(timeX, timeY);
-    timeSprite.deleteSprite();
+    int top = y - layout.height / 2;
+    if (layout.width <= maxWidth) {
+        sprite.blit(layout.strip, x - layout.width / 2, top);
+        return;
+    }
+
+    // Too wide - show the leading part inside the available width
+    int left = x - maxWidth / 2;
+    sprite.setClipRect(left, top, maxWidth, layout.height);
+    sprite.blit(layout.strip, left, top);
+    sprite.clearClipRect();
 }
 
-uint16_t getTemperatureColor(float temp) {
-    // Map temperature to color gradient: blue -> cyan -> green -> yellow -> orange -> red
-    float percent = (temp - TEMP_MIN) / (TEMP_MAX - TEMP_MIN);
-
-    uint8_t r, g, b;
-
-    if (percent < 0.25) {
-        // Blue to Cyan
-        float t = percent / 0.25;
-        r = 0;
-        g = (uint8_t)(255 * t);
-        b = 255;
-    } else if (percent < 0.5) {
-        // Cyan to Green
-        float t = (percent - 0.25) / 0.25;
-        r = 0;
-        g = 255;
-        b = (uint8_t)(255 * (1 - t));
-    } else if (percent < 0.75) {
-        // Green to Yellow/Orange
-        float t = (percent - 0.5) / 0.25;
-        r = (uint8_t)(255 * t);
-        g = 255;
-        b = 0;
-    } else {
-        // Orange to Red
-        float t = (percent - 0.75) / 0.25;
-        r = 255;
-        g = (uint8_t)(255 * (1 - t));
-        b = 0;
+// Draw the active carousel label. If it overflows it becomes the marquee
+// and updateMarquee() scrolls it from the loop.
+void drawMarqueeLabel(const char* text, const lgfx::IFont* font, uint16_t fgColor, uint16_t bgColor,
+                      int x, int y) {
+    TextLayout& layout = getTextLayout(text, font, fgColor, bgColor);
+
+    if (!layout.valid || layout.width <= LABEL_MAX_WIDTH) {
+        drawCachedLabel(text, font, fgColor, bgColor, x, y, LABEL_MAX_WIDTH);
+        return;
+    }
+
+    // Different label than last frame - restart from the beginning after a pause
+    if (marquee.layout != &layout || marquee.hash != layout.hash) {
+        marquee.layout = &layout;
+        marquee.hash = layout.hash;
+        marquee.offset = 0;
+        marquee.holdUntil = millis() + MARQUEE_HOLD_MS;
     }
+    marquee.active = true;
+    marquee.x = x;
+    marquee.y = y;
+
+    pushMarqueeStrip(&sprite, x - LABEL_MAX_WIDTH / 2, y - layout.height / 2);
+}
+
+// Push the marquee strip into dst at the current offset, wrapping around with a gap
+void pushMarqueeStrip(LovyanGFX* dst, int left, int top) {
+    TextLayout& layout = *marquee.layout;
+    int period = layout.width + MARQUEE_GAP_PX;
 
-    // Convert to RGB565
-    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    dst->setClipRect(left, top, LABEL_MAX_WIDTH, layout.height);
+    layout.strip.pushSprite(dst, left - marquee.offset, top);
+    layout.strip.pushSprite(dst, left - marquee.offset + period, top);
+    dst->clearClipRect();
+    if (dst == &sprite) sprite.primitives += 2;
 }
 
-uint16_t getTemperatureColorNight(float temp) {
-    // Map temperature to red gradient: dark red -> medium red -> bright red
-    float percent = (temp - TEMP_MIN) / (TEMP_MAX - TEMP_MIN);
+void updateMarquee() {
+    if (!marquee.active) return;
 
-    uint8_t r, g, b;
+    unsigned long now = millis();
+    if ((long)(now - marquee.holdUntil) < 0 || now - marquee.lastFrame < MARQUEE_FRAME_MS) return;
+    marquee.lastFrame = now;
 
-    // Gradient from dark red (64, 0, 0) to bright red (255, 0, 0)
-    r = (uint8_t)(64 + 191 * percent);
-    g = 0;
-    b = 0;
+    TextLayout& layout = *marquee.layout;
+    marquee.offset += MARQUEE_STEP_PX;
+    if (marquee.offset >= layout.width + MARQUEE_GAP_PX) {
+        // Completed a pass - pause again at the start
+        marquee.offset = 0;
+        marquee.holdUntil = now + MARQUEE_HOLD_MS;
+    }
 
-    // Convert to RGB565
-    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    // Compose just the label row and push it - the rest of the screen is untouched
+    if (marqueeRow.width() != LABEL_MAX_WIDTH || marqueeRow.height() != layout.height) {
+        marqueeRow.deleteSprite();
+        marqueeRow.createSprite(LABEL_MAX_WIDTH, layout.height);
+    }
+    marqueeRow.fillSprite(layout.bgColor);
+    pushMarqueeStrip(&marqueeRow, 0, 0);
+    unsigned long pushStart = micros();
+    marqueeRow.pushSprite(marquee.x - LABEL_MAX_WIDTH / 2, marquee.y - layout.height / 2);
+    recordPartialPush(pushStart, LABEL_MAX_WIDTH * layout.height);
 }
 
-float mapFloat(float x, float in_min, float in_max, float out_min, float out_max) {
-    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+// Usable label width at a given row of the round display
+int labelWidthAt(int y) {
+    int dy = y - centerY;
+    int chord = 2 * (int)sqrt((float)(centerX * centerX - dy * dy));
+    return min(chord - 30, LABEL_MAX_WIDTH);
 }
 
-void setupNTP() {
-    if (!wifiConnected) {
-        Serial.println("Cannot setup NTP: WiFi not connected");
-        return;
+// Push the composed sprite to the display and record the frame's timing
+void pushFrame(RenderScreen screen, unsigned long renderStart) {
+    unsigned long pushStart = micros();
+    sprite.pushSprite(0, 0);
+    unsigned long renderEnd = micros();
+
+    RenderStats& stats = renderStats[screen];
+    stats.frames++;
+    stats.rasterMicros += pushStart - renderStart;
+    stats.pushMicros += renderEnd - pushStart;
+    stats.maxFrameMicros = max(stats.maxFrameMicros, (uint32_t)(renderEnd - renderStart));
+    stats.pixelsPushed += SCREEN_WIDTH * SCREEN_HEIGHT;
+    stats.primitives += sprite.primitives;
+    sprite.primitives = 0;
+    if (renderBenchState == RENDER_BENCH_RUNNING || renderDirtyTracking) {
+        stats.dirtyPixels += countDirtyPixels();  // Outside the timed span
     }
+}
 
-    Serial.println("Syncing time with NTP server...");
-    configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
+// Hash every tile of the composed frame; count the pixels in tiles that changed since the last push
+uint32_t countDirtyPixels() {
+    const uint16_t* pixels = (const uint16_t*)sprite.getBuffer();
+    if (!pixels) return 0;
+
+    uint32_t dirty = 0;
+    uint32_t hashes[RENDER_TILE_COLUMNS];
+    for (int row = 0; row < RENDER_TILE_ROWS; row++) {
+        int top = row * RENDER_TILE;
+        int height = min(RENDER_TILE, SCREEN_HEIGHT - top);
+        for (int column = 0; column < RENDER_TILE_COLUMNS; column++) hashes[column] = 2166136261u;
+
+        for (int y = top; y < top + height; y++) {
+            const uint16_t* line = pixels + y * SCREEN_WIDTH;
+            for (int x = 0; x < SCREEN_WIDTH; x++) {
+                uint32_t& hash = hashes[x / RENDER_TILE];
+                hash = (hash ^ line[x]) * 16777619u;
+            }
+        }
 
-    // Wait for time to be set
-    struct tm timeinfo;
+        for (int column = 0; column < RENDER_TILE_COLUMNS; column++) {
+            if (hashes[column] == frameTileHashes[row][column]) continue;
+            frameTileHashes[row][column] = hashes[column];
+            dirty += min(RENDER_TILE, SCREEN_WIDTH - column * RENDER_TILE) * height;
+        }
+    }
+    return dirty;
+}
+
+void recordPartialPush(unsigned long pushStart, uint32_t pixels) {
+    uint32_t elapsed = micros() - pushStart;
+    RenderStats& stats = renderStats[RENDER_PARTIAL];
+    stats.frames++;
+    stats.pushMicros += elapsed;
+    stats.maxFrameMicros = max(stats.maxFrameMicros, elapsed);
+    stats.pixelsPushed += pixels;
+}
+
+// Draw a screen by id (used by the render benchmark and screenshots)
+void renderScreen(RenderScreen screen) {
+    switch (screen) {
+        case RENDER_TEMPERATURE: drawTemperatureUI(); break;
+        case RENDER_SETTINGS: drawSettingsMenu(); break;
+        case RENDER_IP_EDITOR: drawIPEditor(); break;
+        case RENDER_WIFI_SCANNER: drawWiFiScanner(); break;
+        case RENDER_PASSWORD: drawPasswordEntry(); break;
+        case RENDER_AMBIENT: drawAmbientFace(); break;
+        default: break;
+    }
+}
+
+void redrawCurrentScreen() {
+    if (!inSettingsMenu) {
+        drawTemperatureUI();
+    } else if (currentSubMenu == SUBMENU_IP_EDITOR) {
+        drawIPEditor();
+    } else if (currentSubMenu == SUBMENU_WIFI_SCAN) {
+        drawWiFiScanner();
+    } else if (currentSubMenu == SUBMENU_WIFI_PASSWORD) {
+        drawPasswordEntry();
+    } else {
+        drawSettingsMenu();
+    }
+}
+
+// Switch to the ambient face once the display has dimmed (main screen only)
+void enterAmbientFace() {
+    ambientFaceActive = true;
+    Serial.println("Ambient face on");
+    drawAmbientFace();
+}
+
+void exitAmbientFace() {
+    ambientFaceActive = false;
+    Serial.println("Ambient face off");
+    lastClockUpdate = millis();
+    if (!inSettingsMenu) {
+        drawTemperatureUI();
+    }
+}
+
+// Full ambient frame: large time and the active setpoint, nothing else.
+// Only drawn on entry and when state changes - the minute tick uses updateAmbientClock()
+void drawAmbientFace() {
+    unsigned long renderStart = micros();
+    const Theme& theme = activeTheme();
+    bool activePowerOn = zones[activeZone].powerOn;
+    float activeTemp = getActiveSetpoint();
+
+    sprite.fillSprite(theme.background);
+    pressRingDrawnAngle = 0;
+
+    drawAmbientTime(&sprite, centerX, AMBIENT_TIME_Y, theme.text);
+
+    // Active setpoint below, dimmed further if the side is off
+    char tempStr[10];
+    if (useFahrenheit) {
+        snprintf(tempStr, sizeof(tempStr), "%.0f", celsiusToFahrenheit(activeTemp));
+    } else {
+        snprintf(tempStr, sizeof(tempStr), "%.1f", activeTemp);
+    }
+    sprite.setTextColor(activePowerOn ? theme.setpoint : theme.arcBg);
+    sprite.setFont(&fonts::FreeSansBold18pt7b);
+    sprite.setTextDatum(middle_center);
+    int tempWidth = sprite.textWidth(tempStr);
+    sprite.drawString(tempStr, centerX - 8, AMBIENT_SETPOINT_Y);
+    sprite.setFont(&fonts::FreeSans12pt7b);
+    sprite.setTextDatum(middle_left);
+    sprite.drawString(useFahrenheit ? "F" : "C", centerX - 8 + tempWidth / 2 + 4, AMBIENT_SETPOINT_Y);
+
+    pushFrame(RENDER_AMBIENT, renderStart);
+
+    time_t now = time(nullptr);
+    ambientLastMinute = now / 60;
+}
+
+// HH:MM in the 7-segment font, centered at (x, y)
+void drawAmbientTime(LovyanGFX* dst, int x, int y, uint16_t color) {
+    char timeStr[6] = "--:--";
+    if (timeInitialized) {
+        struct tm timeinfo;
+        if (getLocalTime(&timeinfo, 0)) {
+            snprintf(timeStr, sizeof(timeStr), "%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
+        }
+    }
+
+    dst->setFont(&fonts::Font7);
+    dst->setTextColor(color);
+    dst->setTextDatum(middle_center);
+    dst->drawString(timeStr, x, y);
+    if (dst == &sprite) sprite.primitives++;
+}
+
+// Once-a-minute ambient update - pushes only the time digits
+void updateAmbientClock() {
+    time_t now = time(nullptr);
+    if (now / 60 == ambientLastMinute) return;
+    ambientLastMinute = now / 60;
+
+    const Theme& theme = activeTheme();
+    LGFX_Sprite timeSprite(&M5Dial.Display);
+    timeSprite.setFont(&fonts::Font7);
+    const int timeWidth = timeSprite.textWidth("88:88") + 8;
+    const int timeHeight = timeSprite.fontHeight();
+
+    timeSprite.createSprite(timeWidth, timeHeight);
+    timeSprite.fillSprite(theme.background);
+    drawAmbientTime(&timeSprite, timeWidth / 2, timeHeight / 2, theme.text);
+
+    unsigned long pushStart = micros();
+    timeSprite.pushSprite(centerX - timeWidth / 2, AMBIENT_TIME_Y - timeHeight / 2);
+    recordPartialPush(pushStart, timeWidth * timeHeight);
+    timeSprite.deleteSprite();
+}
+
+void updateClockDisplay() {
+    const Theme& theme = activeTheme();
+    uint16_t bgColor = theme.background;
+    uint16_t textColor = theme.text;
+
+    // Create a small sprite just for the time area (centered, about 80 pixels wide, 15 pixels tall to cover ghost text)
+    LGFX_Sprite timeSprite(&M5Dial.Display);
+    const int timeWidth = 80;
+    const int timeHeight = 15;
+    const int timeX = centerX - timeWidth / 2;
+    const int timeY = SCREEN_HEIGHT - 30 - (timeHeight / 2);  // Center around Y position used in drawTemperatureUI
+
+    timeSprite.createSprite(timeWidth, timeHeight);
+    timeSprite.fillSprite(bgColor);
+
+    // Draw time to sprite
+    if (timeInitialized) {
+        struct tm timeinfo;
+        if (getLocalTime(&timeinfo)) {
+            timeSprite.setFont(&fonts::Font0);
+            timeSprite.setTextColor(textColor);
+            timeSprite.setTextDatum(middle_center);
+
+            char timeStr[10];
+            snprintf(timeStr, sizeof(timeStr), "%02d:%02d:%02d",
+                     timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
+            // Draw at vertical center of sprite
+            timeSprite.drawString(timeStr, timeWidth / 2, timeHeight / 2);
+        }
+    }
+
+    // Push only the time sprite to the specific location
+    unsigned long pushStart = micros();
+    timeSprite.pushSprite(timeX, timeY);
+    recordPartialPush(pushStart, timeWidth * timeHeight);
+    timeSprite.deleteSprite();
+}
+
+float mapFloat(float x, float in_min, float in_max, float out_min, float out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+void setupNTP() {
+    if (!wifiConnected) {
+        Serial.println("Cannot setup NTP: WiFi not connected");
+        return;
+    }
+
+    Serial.println("Syncing time with NTP server...");
+    configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
+
+    // Wait for time to be set
+    struct tm timeinfo;
     int attempts = 0;
     while (!getLocalTime(&timeinfo) && attempts < 10) {
         delay(500);
@@ -1458,6 +3040,32 @@ bool isNightTime() {
     }
 }
 
+bool isEveningTime() {
+    if (!timeInitialized) {
+        return false;
+    }
+
+    struct tm timeinfo;
+    if (!getLocalTime(&timeinfo)) {
+        return false;
+    }
+
+    // Evening runs from EVENING_START_HOUR (20:00) until night mode takes over
+    int hour = timeinfo.tm_hour;
+    return hour >= EVENING_START_HOUR && hour < NIGHT_START_HOUR;
+}
+
+ThemeId activeThemeId() {
+    if (themeOverride >= 0) return (ThemeId)themeOverride;
+    if (isNightTime()) return THEME_NIGHT;
+    if (isEveningTime()) return THEME_EVENING;
+    return THEME_DAY;
+}
+
+const Theme& activeTheme() {
+    return THEMES[activeThemeId()];
+}
+
 void recordActivity() {
     lastActivityTime = millis();
 
@@ -1489,23 +3097,52 @@ void updateBrightness() {
         isDimmed = false;
     }
 
-    // Set brightness
-    M5Dial.Display.setBrightness(targetBrightness);
+    // Set brightness (only when it changes)
+    static int currentBrightness = -1;
+    if (targetBrightness != currentBrightness) {
+        currentBrightness = targetBrightness;
+        M5Dial.Display.setBrightness(targetBrightness);
+    }
+
+    // The ambient face follows the dim state on the main screen
+    if (isDimmed && !ambientFaceActive && !inSettingsMenu) {
+        enterAmbientFace();
+    } else if (ambientFaceActive && (!isDimmed || inSettingsMenu)) {
+        exitAmbientFace();
+    }
 }
 
 float& getActiveSetpoint() {
-    return pillowModeActive ? pillowSetpoint : bedSetpoint;
+    return zones[activeZone].setpoint;
+}
+
+void selectZone(FreeSleepZone zone) {
+    // A setpoint still in its debounce window goes out now rather than wait on a zone no longer shown
+    if (pendingFreeSleepUpdate && pendingFreeSleepZone != zone) sendPendingFreeSleepUpdate();
+    activeZone = zone;
+    if (zone != ZONE_BED) lastOtherZone = zone;
+    Serial.printf("Switched to %s mode\n", zoneName(zone));
+}
+
+// The settings carousel has one controller-IP row per zone; every other item is one row
+int menuRowCount() {
+    return MENU_COUNT - 1 + zoneCount;
 }
 
-float& getInactiveSetpoint() {
-    return pillowModeActive ? bedSetpoint : pillowSetpoint;
+MenuItem menuRowItem(int row, FreeSleepZone& zone) {
+    zone = ZONE_BED;
+    if (row < MENU_ZONE_IP) return (MenuItem)row;
+    if (row < MENU_ZONE_IP + zoneCount) {
+        zone = (FreeSleepZone)(row - MENU_ZONE_IP);
+        return MENU_ZONE_IP;
+    }
+    return (MenuItem)(row - zoneCount + 1);
 }
 
-String getMenuItemName(MenuItem item) {
+String getMenuItemName(MenuItem item, FreeSleepZone zone) {
     switch (item) {
         case MENU_WIFI_SETTINGS: return "WiFi Settings";
-        case MENU_BED_IP: return "Bed Controller IP";
-        case MENU_PILLOW_IP: return "Pillow Controller IP";
+        case MENU_ZONE_IP: return String(zoneName(zone)) + " Controller IP";
         case MENU_BED_SIDE: return "Bed Side";
         case MENU_TEMP_UNIT: return "Temperature Unit";
         case MENU_NIGHT_MODE: return "Night Mode";
@@ -1531,7 +3168,8 @@ void handleEncoderInSettings() {
             int steps = encoderAccumulator / 4;
             encoderAccumulator = encoderAccumulator % 4;  // Keep remainder
 
-            currentMenuItem = (MenuItem)(((int)currentMenuItem + steps + MENU_COUNT) % MENU_COUNT);
+            int rowCount = menuRowCount();
+            currentMenuRow = ((currentMenuRow + steps) % rowCount + rowCount) % rowCount;
             drawSettingsMenu();
         }
     }
@@ -1539,22 +3177,25 @@ void handleEncoderInSettings() {
     // Handle encoder button press - select menu item
     if (M5Dial.BtnA.wasPressed()) {
         recordActivity();
-        Serial.printf("Selected: %s\n", getMenuItemName(currentMenuItem).c_str());
+        FreeSleepZone rowZone;
+        MenuItem item = menuRowItem(currentMenuRow, rowZone);
+        Serial.printf("Selected: %s\n", getMenuItemName(item, rowZone).c_str());
 
-        switch (currentMenuItem) {
+        switch (item) {
             case MENU_WIFI_SETTINGS:
                 startWiFiScanner();
                 break;
-            case MENU_BED_IP:
-                startIPEditor(true);  // Edit bed IP
-                break;
-            case MENU_PILLOW_IP:
-                startIPEditor(false);  // Edit pillow IP
+            case MENU_ZONE_IP:
+                startIPEditor(rowZone);
                 break;
             case MENU_BED_SIDE:
                 // Toggle bed side (left/right)
                 bedSideRight = !bedSideRight;
                 preferences.putBool("bedSideRight", bedSideRight);
+                memset(podTempF, 0, sizeof(podTempF));  // The other side's setpoints aren't known yet
+                // Unsent changes were meant for the old side; take the new side's state as it is
+                for (int zone = 0; zone < MAX_ZONES; zone++) dropOutboxEntry((FreeSleepZone)zone);
+                saveOutbox();
                 Serial.printf("Bed side: %s (saved)\n", bedSideRight ? "Right" : "Left");
                 drawSettingsMenu();
                 break;
@@ -1572,9 +3213,8 @@ void handleEncoderInSettings() {
                 drawSettingsMenu();
                 break;
             case MENU_TEMPERATURE_MODE:
-                // Toggle temperature mode
-                pillowModeActive = !pillowModeActive;
-                Serial.printf("Temperature mode: %s\n", pillowModeActive ? "Pillow" : "Bed");
+                // Step to the next zone
+                selectZone((activeZone + 1) % zoneCount);
                 drawSettingsMenu();
                 break;
             default:
@@ -1583,30 +3223,31 @@ void handleEncoderInSettings() {
     }
 }
 
-void startIPEditor(bool isBedIP) {
-    editingBedIP = isBedIP;
+void startIPEditor(FreeSleepZone zone) {
+    editingZone = zone;
     currentSubMenu = SUBMENU_IP_EDITOR;
     ipEditorOctet = 0;
     ipEditorDigit = 0;
     lastEncoderPosition = M5Dial.Encoder.read();  // Sync encoder position
 
     // Copy current IP to temp array
-    IPAddress& targetIP = isBedIP ? bedTargetIP : pillowTargetIP;
+    IPAddress& targetIP = zoneTargetIP(zone);
     for (int i = 0; i < 4; i++) {
         tempIPOctets[i] = targetIP[i];
     }
 
-    Serial.printf("Editing %s IP: %d.%d.%d.%d\n", isBedIP ? "Bed" : "Pillow",
+    Serial.printf("Editing %s IP: %d.%d.%d.%d\n", zoneName(zone),
                   tempIPOctets[0], tempIPOctets[1], tempIPOctets[2], tempIPOctets[3]);
 
     drawIPEditor();
 }
 
 void drawIPEditor() {
-    bool nightMode = isNightTime();
-    uint16_t bgColor = nightMode ? COLOR_NIGHT_BACKGROUND : COLOR_BACKGROUND;
-    uint16_t textColor = nightMode ? COLOR_NIGHT_TEXT : COLOR_TEXT;
-    uint16_t accentColor = nightMode ? COLOR_NIGHT_SETPOINT : COLOR_SETPOINT;
+    unsigned long renderStart = micros();
+    const Theme& theme = activeTheme();
+    uint16_t bgColor = theme.background;
+    uint16_t textColor = theme.text;
+    uint16_t accentColor = theme.setpoint;
 
     sprite.fillSprite(bgColor);
 
@@ -1614,7 +3255,7 @@ void drawIPEditor() {
     sprite.setTextColor(accentColor);
     sprite.setTextDatum(middle_center);
     sprite.setFont(&fonts::FreeSans12pt7b);
-    sprite.drawString(editingBedIP ? "Bed IP Address" : "Pillow IP Address", centerX, centerY - 40);
+    sprite.drawString((String(zoneName(editingZone)) + " IP Address").c_str(), centerX, centerY - 40);
 
     // Draw IP address with current octet highlighted
     sprite.setFont(&fonts::FreeSansBold9pt7b);
@@ -1659,7 +3300,7 @@ void drawIPEditor() {
     sprite.drawString("Turn to change | Click for next", centerX, centerY + 35);
     sprite.drawString("Tap to save and exit", centerX, centerY + 50);
 
-    sprite.pushSprite(0, 0);
+    pushFrame(RENDER_IP_EDITOR, renderStart);
 }
 
 void handleEncoderInIPEditor() {
@@ -1696,23 +3337,23 @@ void handleEncoderInIPEditor() {
 
         if (ipEditorOctet >= 4) {
             // Finished editing all octets - save and exit
-            IPAddress& targetIP = editingBedIP ? bedTargetIP : pillowTargetIP;
-            targetIP = IPAddress(tempIPOctets[0], tempIPOctets[1], tempIPOctets[2], tempIPOctets[3]);
-
-            // Save to NVS
-            if (editingBedIP) {
-                preferences.putUChar("bedIP0", tempIPOctets[0]);
-                preferences.putUChar("bedIP1", tempIPOctets[1]);
-                preferences.putUChar("bedIP2", tempIPOctets[2]);
-                preferences.putUChar("bedIP3", tempIPOctets[3]);
-            } else {
-                preferences.putUChar("pillowIP0", tempIPOctets[0]);
-                preferences.putUChar("pillowIP1", tempIPOctets[1]);
-                preferences.putUChar("pillowIP2", tempIPOctets[2]);
-                preferences.putUChar("pillowIP3", tempIPOctets[3]);
+            IPAddress& targetIP = zoneTargetIP(editingZone);
+            IPAddress entered(tempIPOctets[0], tempIPOctets[1], tempIPOctets[2], tempIPOctets[3]);
+            int other = zoneOnController(entered, editingZone);
+            if (other >= 0) {
+                // Start the address over rather than put two zones on one controller
+                Serial.printf("%s is already %s's controller - not saved\n", entered.toString().c_str(), zoneName(other));
+                ipEditorOctet = 0;
+                drawIPEditor();
+                return;
             }
+            targetIP = entered;
 
-            Serial.printf("Saved %s IP: %s (to NVS)\n", editingBedIP ? "Bed" : "Pillow", targetIP.toString().c_str());
+            // Save to NVS; a hand-entered IP drops the old identity (relearned on the next browse)
+            saveZoneTargetIP(editingZone);
+            setZoneController(editingZone, "");
+
+            Serial.printf("Saved %s IP: %s (to NVS)\n", zoneName(editingZone), targetIP.toString().c_str());
 
             // Return to settings menu
             currentSubMenu = SUBMENU_NONE;
@@ -1750,13 +3391,15 @@ void startWiFiScanner() {
 }
 
 void drawWiFiScanner() {
-    bool nightMode = isNightTime();
-    uint16_t bgColor = nightMode ? COLOR_NIGHT_BACKGROUND : COLOR_BACKGROUND;
-    uint16_t textColor = nightMode ? COLOR_NIGHT_TEXT : COLOR_TEXT;
-    uint16_t accentColor = nightMode ? COLOR_NIGHT_SETPOINT : COLOR_SETPOINT;
-    uint16_t dimTextColor = nightMode ? 0x4000 : 0x4208;
+    unsigned long renderStart = micros();
+    const Theme& theme = activeTheme();
+    uint16_t bgColor = theme.background;
+    uint16_t textColor = theme.text;
+    uint16_t accentColor = theme.setpoint;
+    uint16_t dimTextColor = theme.dimText;
 
     sprite.fillSprite(bgColor);
+    marquee.active = false;  // Re-armed below if the selected SSID overflows
 
     // Draw title
     sprite.setTextColor(accentColor);
@@ -1783,22 +3426,20 @@ void drawWiFiScanner() {
             if (yPos < 50 || yPos > SCREEN_HEIGHT - 30) continue;
 
             if (i == 0) {
-                // Active network - centered, larger, bold
-                sprite.setFont(&fonts::FreeSansBold12pt7b);
-                sprite.setTextColor(accentColor);
-                sprite.setTextDatum(middle_center);
-                sprite.drawString(scannedSSIDs[networkIndex].c_str(), centerX, yPos);
+                // Active network - centered, larger, bold, scrolls if too long
+                drawMarqueeLabel(scannedSSIDs[networkIndex].c_str(), &fonts::FreeSansBold12pt7b,
+                                 accentColor, bgColor, centerX, yPos);
 
                 // Draw selection arrows
                 sprite.setFont(&fonts::FreeSans9pt7b);
+                sprite.setTextColor(accentColor);
+                sprite.setTextDatum(middle_center);
                 sprite.drawString(">", centerX - 100, yPos);
                 sprite.drawString("<", centerX + 100, yPos);
             } else {
                 // Non-active networks
-                sprite.setFont(&fonts::FreeSans9pt7b);
-                sprite.setTextColor(dimTextColor);
-                sprite.setTextDatum(middle_center);
-                sprite.drawString(scannedSSIDs[networkIndex].c_str(), centerX, yPos);
+                drawCachedLabel(scannedSSIDs[networkIndex].c_str(), &fonts::FreeSans9pt7b,
+                                dimTextColor, bgColor, centerX, yPos, labelWidthAt(yPos));
             }
         }
 
@@ -1809,7 +3450,7 @@ void drawWiFiScanner() {
         sprite.drawString("Turn to select | Click to connect | Tap to cancel", centerX, SCREEN_HEIGHT - 10);
     }
 
-    sprite.pushSprite(0, 0);
+    pushFrame(RENDER_WIFI_SCANNER, renderStart);
 }
 
 void handleEncoderInWiFiScanner() {
@@ -1858,10 +3499,11 @@ void startPasswordEntry() {
 }
 
 void drawPasswordEntry() {
-    bool nightMode = isNightTime();
-    uint16_t bgColor = nightMode ? COLOR_NIGHT_BACKGROUND : COLOR_BACKGROUND;
-    uint16_t textColor = nightMode ? COLOR_NIGHT_TEXT : COLOR_TEXT;
-    uint16_t accentColor = nightMode ? COLOR_NIGHT_SETPOINT : COLOR_SETPOINT;
+    unsigned long renderStart = micros();
+    const Theme& theme = activeTheme();
+    uint16_t bgColor = theme.background;
+    uint16_t textColor = theme.text;
+    uint16_t accentColor = theme.setpoint;
 
     sprite.fillSprite(bgColor);
 
@@ -1923,7 +3565,7 @@ void drawPasswordEntry() {
     sprite.drawString("Turn to select char | Click to add | Long press to connect", centerX, SCREEN_HEIGHT - 20);
     sprite.drawString("Tap screen to cancel", centerX, SCREEN_HEIGHT - 10);
 
-    sprite.pushSprite(0, 0);
+    pushFrame(RENDER_PASSWORD, renderStart);
 }
 
 void handleEncoderInPasswordEntry() {
@@ -1967,9 +3609,9 @@ void handleEncoderInPasswordEntry() {
         WiFi.begin(scannedSSIDs[selectedSSIDIndex].c_str(), wifiPasswordInput.c_str());
 
         // Get colors for status messages
-        bool nightMode = isNightTime();
-        uint16_t bgColor = nightMode ? COLOR_NIGHT_BACKGROUND : COLOR_BACKGROUND;
-        uint16_t accentColor = nightMode ? COLOR_NIGHT_SETPOINT : COLOR_SETPOINT;
+        const Theme& theme = activeTheme();
+        uint16_t bgColor = theme.background;
+        uint16_t accentColor = theme.setpoint;
 
         // Show connecting message
         sprite.fillSprite(bgColor);
@@ -2003,7 +3645,7 @@ void handleEncoderInPasswordEntry() {
 
             // Show success
             sprite.fillSprite(bgColor);
-            sprite.setTextColor(COLOR_SETPOINT);
+            sprite.setTextColor(accentColor);
             sprite.setFont(&fonts::FreeSans12pt7b);
             sprite.drawString("Connected!", centerX, centerY);
             sprite.pushSprite(0, 0);
@@ -2013,7 +3655,7 @@ void handleEncoderInPasswordEntry() {
 
             // Show error
             sprite.fillSprite(bgColor);
-            sprite.setTextColor(0xF800);  // Red
+            sprite.setTextColor(theme.arcHot);  // Red
             sprite.setFont(&fonts::FreeSans12pt7b);
             sprite.drawString("Connection Failed", centerX, centerY);
             sprite.pushSprite(0, 0);
@@ -2037,231 +3679,1687 @@ float fahrenheitToCelsius(float fahrenheit) {
     return (fahrenheit - 32.0f) * 5.0f / 9.0f;
 }
 
-// Fetch current temperature setpoint and power state from FreeSleep API
-// side should be "left" or "right"
-bool fetchFreeSleepTemperature(IPAddress ip, const char* side, float& tempCelsius, bool& isOn) {
-    if (!wifiConnected) return false;
+// The controller's pooled connection if it has a slot, without touching the pool (read-only callers)
+const FreeSleepConnection* findFreeSleepConnection(IPAddress ip) {
+    for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS; i++) {
+        const FreeSleepConnection& conn = freeSleepConnections[i];
+        if (conn.assigned && conn.ip == ip) return &conn;
+    }
+    return nullptr;
+}
 
-    HTTPClient http;
-    String url = "http://" + ip.toString() + ":3000/api/deviceStatus";
+// Get the pooled connection for a controller, assigning a slot if it has none.
+// Takes a free slot first, otherwise the least recently used one. A slot is held - never
+// repurposed - while its worker is busy and for the rest of the cycle that acquired it, even
+// if its job was skipped (its breaker and stats stay with its controller). If every slot
+// is held, a busy one left from an earlier cycle comes back and the caller skips it.
+FreeSleepConnection& acquireFreeSleepConnection(IPAddress ip) {
+    auto held = [](const FreeSleepConnection& conn) { return conn.busy || conn.cycle == freeSleepCycle; };
+    FreeSleepConnection* slot = nullptr;
+    FreeSleepConnection* late = nullptr;  // Busy with a job from an earlier cycle
+    for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS; i++) {
+        FreeSleepConnection& conn = freeSleepConnections[i];
+        if (conn.assigned && conn.ip == ip) {
+            conn.lastUsed = millis();
+            conn.cycle = freeSleepCycle;
+            return conn;
+        }
+        if (held(conn)) {
+            if (conn.busy && conn.cycle != freeSleepCycle) late = &conn;
+            continue;
+        }
+        if (!slot || (slot->assigned && (!conn.assigned || conn.lastUsed < slot->lastUsed))) slot = &conn;
+    }
+    if (!slot) return late ? *late : freeSleepConnections[0];  // No late one can't happen: one slot per zone
+    slot->cycle = freeSleepCycle;
+
+    // Repurpose the slot for this controller
+    slot->client.stop();
+    slot->assigned = true;
+    slot->ip = ip;
+    snprintf(slot->host, sizeof(slot->host), "%u.%u.%u.%u:%u", ip[0], ip[1], ip[2], ip[3], FREESLEEP_PORT);
+    slot->lastUsed = millis();
+    slot->requests = 0;
+    slot->breaker = BREAKER_CLOSED;
+    slot->failures = 0;
+    slot->backoffMs = 0;
+    memset(slot->ops, 0, sizeof(slot->ops));
+    return *slot;
+}
 
-    http.begin(url);
-    http.setTimeout(2000);  // 5 second timeout to debug
-    http.setConnectTimeout(2000);  // 5 second connection timeout to debug
+// Whether a request to this controller may go out now. probe = a user write, which is
+// sent even while the breaker is open (the user wants to try again).
+bool freeSleepBreakerAllows(FreeSleepConnection& conn, bool probe) {
+    if (conn.breaker == BREAKER_OPEN && (probe || (long)(millis() - conn.probeAt) >= 0)) {
+        conn.breaker = BREAKER_HALF_OPEN;
+        Serial.printf("FreeSleep %s breaker half-open - probing\n", conn.host);
+    }
+    return conn.breaker != BREAKER_OPEN;
+}
 
-    int httpCode = http.GET();
+void recordFreeSleepResult(FreeSleepConnection& conn, bool success) {
+    if (success) {
+        if (conn.breaker != BREAKER_CLOSED || conn.failures > 0) {
+            Serial.printf("FreeSleep %s recovered after %d failures\n", conn.host, conn.failures);
+        }
+        conn.breaker = BREAKER_CLOSED;
+        conn.failures = 0;
+        conn.backoffMs = 0;
+        return;
+    }
 
-    if (httpCode == HTTP_CODE_OK) {
-        String payload = http.getString();
-        JsonDocument doc;
-        DeserializationError error = deserializeJson(doc, payload);
+    if (conn.failures < 255) conn.failures++;
+    if (conn.breaker == BREAKER_HALF_OPEN || conn.failures >= FREESLEEP_BREAKER_THRESHOLD) {
+        // Exponential backoff with equal jitter, so dials sharing a pod don't probe in lockstep
+        conn.backoffMs = conn.backoffMs ? min(conn.backoffMs * 2, FREESLEEP_BREAKER_MAX_MS)
+                                        : FREESLEEP_BREAKER_MIN_MS;
+        unsigned long wait = conn.backoffMs / 2 + random(conn.backoffMs / 2 + 1);
+        conn.breaker = BREAKER_OPEN;
+        conn.probeAt = millis() + wait;
+        discoveryRequested = true;  // The pod may have moved - look for it
+        if (freeSleepDiscoveryTaskHandle) xTaskNotifyGive(freeSleepDiscoveryTaskHandle);
+        Serial.printf("FreeSleep %s breaker open (%d consecutive failures), probing in %lums\n",
+                     conn.host, conn.failures, wait);
+    }
+}
 
-        if (!error) {
-            if (doc[side]["targetTemperatureF"].is<float>()) {
-                float tempF = doc[side]["targetTemperatureF"].as<float>();
-                tempCelsius = fahrenheitToCelsius(tempF);
-                isOn = doc[side]["isOn"].as<bool>();
-                Serial.printf("FreeSleep %s: %.1f°F = %.1f°C, power: %s\n",
-                             side, tempF, tempCelsius, isOn ? "ON" : "OFF");
-                http.end();
-                return true;
+// Send a GET (payload == nullptr) or POST on the controller's pooled connection and read
+// the response head, all before conn.deadline. If a reused keep-alive socket was closed
+// by the pod while idle, reconnect and retry once. The caller reads the body with readFreeSleepBody() (or a
+// FreeSleepBodyReader), then calls finishFreeSleepRequest().
+int sendFreeSleepRequest(FreeSleepConnection& conn, FreeSleepOperation op, const char* payload) {
+    int httpCode = HTTPC_ERROR_NOT_CONNECTED;
+    conn.op = op;
+    conn.requestStart = micros();
+
+    // Formatted once on the stack, before any attempt
+    char request[FREESLEEP_REQUEST_MAX];
+    int length = formatFreeSleepRequest(conn, payload, request, sizeof(request));
+    if (length < 0) return HTTPC_ERROR_SEND_HEADER_FAILED;
+
+    // Everything, including a reconnect, happens before conn.deadline
+    for (int attempt = 0; attempt < 2; attempt++) {
+        bool reused = conn.client.connected();
+
+        if (!reused) {
+            long remaining = (long)(conn.deadline - millis());
+            if (remaining <= 0) {
+                httpCode = HTTPC_ERROR_CONNECTION_REFUSED;
+                break;
+            }
+            unsigned long connectStart = micros();
+            bool connected = conn.client.connect(conn.ip, FREESLEEP_PORT, (int32_t)remaining);
+            recordLatency(conn.ops[op].connect, micros() - connectStart);
+            if (!connected) {
+                httpCode = HTTPC_ERROR_CONNECTION_REFUSED;
+                break;
             }
+            conn.client.setNoDelay(true);
         }
-    } else {
-        Serial.printf("FreeSleep GET failed: %d\n", httpCode);
+
+        if (conn.client.write((const uint8_t*)request, length) != (size_t)length) {
+            httpCode = HTTPC_ERROR_SEND_HEADER_FAILED;
+        } else {
+            httpCode = readFreeSleepResponseHead(conn);
+        }
+
+        if (!reused) {
+            conn.connects++;
+            conn.requests = 0;
+        }
+
+        // A read timeout means the pod is slow, not that the socket is stale - don't double the wait
+        if (httpCode > 0 || !reused || httpCode == HTTPC_ERROR_READ_TIMEOUT) {
+            break;
+        }
+
+        Serial.printf("FreeSleep %s: keep-alive socket closed after %lu requests, reconnecting\n",
+                     conn.host, (unsigned long)conn.requests);
+        conn.client.stop();
     }
 
-    http.end();
-    return false;
+    if (httpCode > 0) {
+        conn.requests++;
+    }
+    return httpCode;
 }
 
-// Set temperature on FreeSleep API
-// side should be "left" or "right"
-bool setFreeSleepTemperature(IPAddress ip, const char* side, float tempCelsius) {
-    if (!wifiConnected) return false;
+// A GET (payload == nullptr) or POST of deviceStatus; the pod only needs the request line,
+// Host and the body. Returns the length, or -1 if it didn't fit.
+int formatFreeSleepRequest(const FreeSleepConnection& conn, const char* payload, char* request, size_t size) {
+    int length;
+    if (payload) {
+        length = snprintf(request, size,
+                          "POST %s HTTP/1.1\r\nHost: %s\r\nContent-Type: application/json\r\n"
+                          "Content-Length: %u\r\n\r\n%s",
+                          FREESLEEP_STATUS_PATH, conn.host, (unsigned)strlen(payload), payload);
+    } else {
+        length = snprintf(request, size, "GET %s HTTP/1.1\r\nHost: %s\r\n\r\n",
+                          FREESLEEP_STATUS_PATH, conn.host);
+    }
+    return (length < 0 || length >= (int)size) ? -1 : length;
+}
 
-    HTTPClient http;
-    String url = "http://" + ip.toString() + ":3000/api/deviceStatus";
+// Drain what's left of the body so the socket lines up with the next response, then keep
+// it for reuse unless the request failed or the pod won't keep it open
+void finishFreeSleepRequest(FreeSleepConnection& conn, int httpCode) {
+    if (httpCode > 0) {
+        while (readFreeSleepBody(conn) >= 0) {}
+    }
 
-    http.begin(url);
-    http.addHeader("Content-Type", "application/json");
-    http.setTimeout(2000);  // 5 second timeout to debug
-    http.setConnectTimeout(2000);  // 5 second connection timeout to debug
+    // Total covers connect, request, and reading/parsing the response body
+    FreeSleepOpStats& stats = conn.ops[conn.op];
+    recordLatency(stats.total, micros() - conn.requestStart);
+    stats.results[classifyFreeSleepResult(httpCode)]++;
 
-    // Convert to Fahrenheit and round to integer (API requires integer)
-    int tempF = (int)round(celsiusToFahrenheit(tempCelsius));
+    if (httpCode <= 0 || !conn.keepAlive) {
+        conn.client.stop();
+    }
+}
 
-    // Clamp to FreeSleep's valid range (55-110°F)
-    if (tempF < 55) tempF = 55;
-    if (tempF > 110) tempF = 110;
+// Read the status line and the headers that frame the body.
+// Returns the HTTP status, or an HTTPC_ERROR code if no response arrived.
+int readFreeSleepResponseHead(FreeSleepConnection& conn) {
+    char line[FREESLEEP_LINE_MAX];
+    if (!readFreeSleepLine(conn, line, sizeof(line))) {
+        return conn.client.connected() ? HTTPC_ERROR_READ_TIMEOUT : HTTPC_ERROR_CONNECTION_LOST;
+    }
+    int httpCode;
+    if (sscanf(line, "HTTP/1.%*d %d", &httpCode) != 1) return HTTPC_ERROR_NO_HTTP_SERVER;
+
+    conn.bodyRemaining = -1;  // Neither length nor chunked: the body runs until the pod closes
+    conn.bodyChunked = false;
+    conn.bodyStarted = false;
+    conn.bodyDone = false;
+    conn.keepAlive = strncmp(line, "HTTP/1.0", 8) != 0;
+
+    for (;;) {
+        if (!readFreeSleepLine(conn, line, sizeof(line))) {
+            return conn.client.connected() ? HTTPC_ERROR_READ_TIMEOUT : HTTPC_ERROR_CONNECTION_LOST;
+        }
+        if (!line[0]) break;  // Blank line ends the head
+
+        // Header names and the values we look at are case-insensitive
+        for (char* c = line; *c; c++) *c = tolower(*c);
+        if (strncmp(line, "content-length:", 15) == 0) {
+            conn.bodyRemaining = atol(line + 15);
+        } else if (strncmp(line, "transfer-encoding:", 18) == 0 && strstr(line, "chunked")) {
+            conn.bodyChunked = true;
+        } else if (strncmp(line, "connection:", 11) == 0) {
+            if (strstr(line, "close")) conn.keepAlive = false;
+            else if (strstr(line, "keep-alive")) conn.keepAlive = true;
+        }
+    }
 
-    // Build JSON payload
-    JsonDocument doc;
-    doc[side]["targetTemperatureF"] = tempF;
+    if (httpCode == HTTP_CODE_NO_CONTENT || httpCode == 304 || httpCode < 200) {
+        conn.bodyChunked = false;
+        conn.bodyRemaining = 0;
+    } else if (conn.bodyChunked) {
+        conn.bodyRemaining = 0;  // First chunk size line comes next
+    } else if (conn.bodyRemaining < 0) {
+        conn.keepAlive = false;
+    }
+    return httpCode;
+}
+
+// Read a line without its CRLF into line, truncating it to fit; false if it never ended
+bool readFreeSleepLine(FreeSleepConnection& conn, char* line, size_t size) {
+    return readFreeSleepLine(conn.client, conn.deadline, line, size);
+}
 
-    String payload;
-    serializeJson(doc, payload);
+bool readFreeSleepLine(WiFiClient& client, unsigned long deadline, char* line, size_t size) {
+    size_t length = 0;
+    for (;;) {
+        int c = readFreeSleepByte(client, deadline);
+        if (c < 0) return false;
+        if (c == '\n') break;
+        if (c != '\r' && length < size - 1) line[length++] = c;
+    }
+    line[length] = '\0';
+    return true;
+}
 
-    Serial.printf("FreeSleep POST to %s: %s\n", url.c_str(), payload.c_str());
+// Next byte from the socket, waiting for it until the request's deadline; -1 on timeout or close
+int readFreeSleepByte(FreeSleepConnection& conn) {
+    return readFreeSleepByte(conn.client, conn.deadline);
+}
 
-    int httpCode = http.POST(payload);
+int readFreeSleepByte(WiFiClient& client, unsigned long deadline) {
+    for (;;) {
+        int c = client.read();
+        if (c >= 0) return c;
+        if (!client.connected() || (long)(millis() - deadline) >= 0) return -1;
+        delay(1);
+    }
+}
 
-    if (httpCode == HTTP_CODE_NO_CONTENT || httpCode == HTTP_CODE_OK) {
-        Serial.printf("FreeSleep %s set to %d°F (%.1f°C)\n", side, tempF, tempCelsius);
-        http.end();
-        return true;
-    } else {
-        Serial.printf("FreeSleep POST failed: %d\n", httpCode);
+// Next byte of the response body with any chunk framing stripped; -1 at the end of the body
+int readFreeSleepBody(FreeSleepConnection& conn) {
+    if (conn.bodyDone) return -1;
+
+    if (conn.bodyChunked && conn.bodyRemaining == 0) {
+        char line[FREESLEEP_LINE_MAX];
+        // The previous chunk's data is followed by CRLF, then the next size line
+        if (conn.bodyStarted && !readFreeSleepLine(conn, line, sizeof(line))) return endFreeSleepBody(conn, false);
+        if (!readFreeSleepLine(conn, line, sizeof(line))) return endFreeSleepBody(conn, false);
+        conn.bodyRemaining = strtol(line, nullptr, 16);
+        conn.bodyStarted = true;
+        if (conn.bodyRemaining < 0) return endFreeSleepBody(conn, false);
+        if (conn.bodyRemaining == 0) {
+            // Last chunk - skip any trailers up to the blank line
+            do {
+                if (!readFreeSleepLine(conn, line, sizeof(line))) return endFreeSleepBody(conn, false);
+            } while (line[0]);
+            return endFreeSleepBody(conn, true);
+        }
+    } else if (conn.bodyRemaining == 0) {
+        return endFreeSleepBody(conn, true);
     }
 
-    http.end();
-    return false;
+    int c = readFreeSleepByte(conn);
+    if (c < 0) return endFreeSleepBody(conn, conn.bodyRemaining < 0 && !conn.client.connected());
+    if (conn.bodyRemaining > 0) conn.bodyRemaining--;
+    return c;
 }
 
-// Set power state on FreeSleep API
-// side should be "left" or "right"
-bool setFreeSleepPower(IPAddress ip, const char* side, bool powerOn) {
-    if (!wifiConnected) return false;
+// A body that broke off leaves the socket mid-response, so it can't be reused
+int endFreeSleepBody(FreeSleepConnection& conn, bool complete) {
+    conn.bodyDone = true;
+    if (!complete) conn.keepAlive = false;
+    return -1;
+}
 
-    HTTPClient http;
-    String url = "http://" + ip.toString() + ":3000/api/deviceStatus";
+void recordLatency(LatencyHistogram& histogram, uint32_t micros) {
+    uint32_t ms = micros / 1000;
+    int bucket = 0;
+    while (bucket < LATENCY_BUCKET_COUNT - 1 && ms >= LATENCY_BUCKET_MS[bucket]) bucket++;
 
-    http.begin(url);
-    http.addHeader("Content-Type", "application/json");
-    http.setTimeout(2000);  // 5 second timeout to debug
-    http.setConnectTimeout(2000);  // 5 second connection timeout to debug
+    histogram.buckets[bucket]++;
+    histogram.count++;
+    histogram.totalMicros += micros;
+    if (micros > histogram.maxMicros) histogram.maxMicros = micros;
+}
 
-    // Build JSON payload
-    JsonDocument doc;
-    doc[side]["isOn"] = powerOn;
+FreeSleepResultClass classifyFreeSleepResult(int httpCode) {
+    if (httpCode >= 200 && httpCode < 600) return (FreeSleepResultClass)(FS_RESULT_2XX + httpCode / 100 - 2);
+    switch (httpCode) {
+        case HTTPC_ERROR_CONNECTION_REFUSED:
+        case HTTPC_ERROR_NOT_CONNECTED:
+            return FS_RESULT_CONNECT;
+        case HTTPC_ERROR_SEND_HEADER_FAILED:
+        case HTTPC_ERROR_SEND_PAYLOAD_FAILED:
+        case HTTPC_ERROR_STREAM_WRITE:
+            return FS_RESULT_SEND;
+        case HTTPC_ERROR_CONNECTION_LOST:
+        case HTTPC_ERROR_NO_STREAM:
+        case HTTPC_ERROR_NO_HTTP_SERVER:
+            return FS_RESULT_LOST;
+        case HTTPC_ERROR_READ_TIMEOUT:
+            return FS_RESULT_TIMEOUT;
+        default:
+            return FS_RESULT_OTHER;
+    }
+}
 
-    String payload;
-    serializeJson(doc, payload);
+// Feeds a response body to the JSON parser (ArduinoJson custom reader)
+struct FreeSleepBodyReader {
+    FreeSleepConnection& conn;
 
-    Serial.printf("FreeSleep power POST to %s: %s\n", url.c_str(), payload.c_str());
+    int read() { return readFreeSleepBody(conn); }
 
-    int httpCode = http.POST(payload);
+    size_t readBytes(char* buffer, size_t length) {
+        size_t count = 0;
+        int c;
+        while (count < length && (c = read()) >= 0) buffer[count++] = c;
+        return count;
+    }
+};
 
-    if (httpCode == HTTP_CODE_NO_CONTENT || httpCode == HTTP_CODE_OK) {
-        Serial.printf("FreeSleep %s power set to %s\n", side, powerOn ? "ON" : "OFF");
-        http.end();
-        return true;
+// Fetch one controller's deviceStatus and parse it into doc, keeping only the fields in filter
+// The body is parsed straight off the socket (chunked or not) into the worker's arena,
+// so memory use doesn't grow with the pod's payload.
+// Runs on the connection's worker; the caller has already checked the breaker.
+bool fetchFreeSleepStatus(FreeSleepConnection& conn, const JsonDocument& filter, JsonDocument& doc) {
+    if (!wifiConnected) return false;
+
+    int httpCode = sendFreeSleepRequest(conn, FS_OP_STATUS, nullptr);
+
+    bool success = false;
+    if (httpCode == HTTP_CODE_OK) {
+        FreeSleepBodyReader body = {conn};
+        DeserializationError error = deserializeJson(doc, body, DeserializationOption::Filter(filter));
+        if (!error) {
+            success = true;
+        } else {
+            Serial.printf("FreeSleep status parse failed: %s\n", error.c_str());
+        }
     } else {
-        Serial.printf("FreeSleep power POST failed: %d\n", httpCode);
+        Serial.printf("FreeSleep GET %s failed: %d\n", conn.host, httpCode);
     }
 
-    http.end();
-    return false;
+    finishFreeSleepRequest(conn, httpCode);
+    recordFreeSleepResult(conn, success);
+    return success;
 }
 
-// Toggle power for the currently active mode (bed or pillow)
-void toggleActivePower() {
-    const char* side = bedSideRight ? "right" : "left";
+// Ask the status parser to keep the fields readFreeSleepSide() needs for one side
+void addFreeSleepSideFilter(JsonDocument& filter, const char* side) {
+    filter[side]["targetTemperatureF"] = true;
+    filter[side]["isOn"] = true;
+}
 
-    if (pillowModeActive) {
-        // Toggle pillow power
-        pillowPowerOn = !pillowPowerOn;
-        Serial.printf("Toggling pillow power to %s\n", pillowPowerOn ? "ON" : "OFF");
-        setFreeSleepPower(pillowTargetIP, side, pillowPowerOn);
-    } else {
-        // Toggle bed power
-        bedPowerOn = !bedPowerOn;
-        Serial.printf("Toggling bed power to %s\n", bedPowerOn ? "ON" : "OFF");
-        setFreeSleepPower(bedTargetIP, side, bedPowerOn);
+// The filter for one side, built on first use and kept for every later refresh
+const JsonDocument& freeSleepStatusFilter(const char* side) {
+    static JsonDocument filters[2];  // Indexed like FREESLEEP_SIDES
+    JsonDocument& filter = filters[strcmp(side, FREESLEEP_SIDES[1]) == 0 ? 1 : 0];
+    if (filter.isNull()) addFreeSleepSideFilter(filter, side);
+    return filter;
+}
+
+// Pull the temperature setpoint and power state for one side out of a parsed status
+// side should be "left" or "right"
+bool readFreeSleepSide(JsonVariantConst status, const char* side, float& tempCelsius, bool& isOn) {
+    if (!status[side]["targetTemperatureF"].is<float>()) return false;
+
+    float tempF = status[side]["targetTemperatureF"].as<float>();
+    tempCelsius = fahrenheitToCelsius(tempF);
+    isOn = status[side]["isOn"].as<bool>();
+    return true;
+}
+
+// FNV-1a over the fields a zone reads from its status; never 0 so 0 can mean "nothing applied"
+uint32_t freeSleepFingerprint(float tempCelsius, bool isOn) {
+    uint8_t bytes[sizeof(float) + 1];
+    memcpy(bytes, &tempCelsius, sizeof(float));
+    bytes[sizeof(float)] = isOn;
+
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(bytes); i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
     }
+    return hash ? hash : 1;
+}
 
-    drawTemperatureUI();
+// Convert to the integer Fahrenheit the API requires, clamped to FreeSleep's valid range (55-110°F)
+int freeSleepTempF(float tempCelsius) {
+    int tempF = (int)round(celsiusToFahrenheit(tempCelsius));
+    if (tempF < 55) tempF = 55;
+    if (tempF > 110) tempF = 110;
+    return tempF;
 }
 
-// Sync temperatures and power state from FreeSleep on startup
-void syncTemperaturesFromFreeSleep() {
-    Serial.println("Syncing temperatures from FreeSleep...");
+// Merge a write command into the batch for its controller (task side)
+void queueFreeSleepWrite(FreeSleepWriteBatch* batches, const FreeSleepCommand& command) {
+    uint32_t ip = command.ip[command.zone];
 
-    float temp;
-    bool isOn;
+    FreeSleepWriteBatch* batch = nullptr;
+    for (int i = 0; i < MAX_ZONES; i++) {
+        if (batches[i].used && batches[i].ip == ip) {
+            batch = &batches[i];
+            break;
+        }
+        if (!batches[i].used && !batch) batch = &batches[i];
+    }
+    if (!batch) return;  // Can't happen: one batch per zone
 
-    const char* side = bedSideRight ? "right" : "left";
+    if (!batch->used) {
+        *batch = {};
+        batch->used = true;
+        batch->ip = ip;
+    }
 
-    // Fetch bed temperature and power state
-    if (fetchFreeSleepTemperature(bedTargetIP, side, temp, isOn)) {
-        bedSetpoint = temp;
-        bedPowerOn = isOn;
-        Serial.printf("Bed synced: %.1f°C, power: %s\n", bedSetpoint, bedPowerOn ? "ON" : "OFF");
+    FreeSleepSideWrite& write = batch->sides[strcmp(command.side, "right") == 0 ? 1 : 0];
+    if (command.setTemperature) {
+        write.hasTemperature = true;
+        write.tempF = freeSleepTempF(command.tempCelsius);
     }
+    if (command.setPower) {
+        write.hasPower = true;
+        write.powerOn = command.powerOn;
+    }
+    if (!command.sequence) return;  // One-off write - no zone is waiting on its result
+    batch->zoneMask |= 1 << command.zone;
+    batch->sequence[command.zone] = command.sequence;
+}
 
-    // Fetch pillow temperature and power state
-    if (fetchFreeSleepTemperature(pillowTargetIP, side, temp, isOn)) {
-        pillowSetpoint = temp;
-        pillowPowerOn = isOn;
-        Serial.printf("Pillow synced: %.1f°C, power: %s\n", pillowSetpoint, pillowPowerOn ? "ON" : "OFF");
+// Format a batch as its POST body, e.g. {"left":{"targetTemperatureF":80,"isOn":true}},
+// and pick the operation it counts as. Returns the length, or -1 if it didn't fit.
+int formatFreeSleepWrite(const FreeSleepWriteBatch& batch, char* payload, size_t size, FreeSleepOperation& op) {
+    bool anyTemperature = false;
+    bool anyPower = false;
+    size_t length = snprintf(payload, size, "{");
+    for (int i = 0; i < 2; i++) {
+        const FreeSleepSideWrite& write = batch.sides[i];
+        if (!write.hasTemperature && !write.hasPower) continue;
+
+        char temperature[32] = "";
+        if (write.hasTemperature) snprintf(temperature, sizeof(temperature), "\"targetTemperatureF\":%d", write.tempF);
+        int written = snprintf(payload + length, size - length, "%s\"%s\":{%s%s%s}",
+                               length > 1 ? "," : "", FREESLEEP_SIDES[i], temperature,
+                               write.hasTemperature && write.hasPower ? "," : "",
+                               !write.hasPower ? "" : write.powerOn ? "\"isOn\":true" : "\"isOn\":false");
+        if (written < 0 || (length += written) >= size) return -1;
+        anyTemperature |= write.hasTemperature;
+        anyPower |= write.hasPower;
     }
+    int written = snprintf(payload + length, size - length, "}");
+    if (written < 0 || (length += written) >= size) return -1;
+
+    op = (anyTemperature && anyPower) ? FS_OP_WRITE_COMBINED :
+         anyPower ? FS_OP_WRITE_POWER : FS_OP_WRITE_TEMPERATURE;
+    return length;
 }
 
-// Periodic sync of temperature and power state from FreeSleep
-void syncFromFreeSleep() {
-    float temp;
-    bool isOn;
-    bool needsRedraw = false;
-    bool anySuccess = false;
+// Send one controller's merged changes as a single deviceStatus POST (on the connection's worker)
+bool postFreeSleepWrite(FreeSleepConnection& conn, const FreeSleepWriteBatch& batch) {
+    if (!wifiConnected) return false;
+
+    char payload[FREESLEEP_PAYLOAD_MAX];
+    FreeSleepOperation op;
+    if (formatFreeSleepWrite(batch, payload, sizeof(payload), op) < 0) {
+        Serial.printf("FreeSleep POST %s: payload too long\n", conn.host);
+        return false;
+    }
 
-    // Don't sync temperature if user recently changed it (prevents overwriting user input)
-    bool allowTempSync = (millis() - lastSetpointChangeTime) > SYNC_COOLDOWN_AFTER_CHANGE_MS;
+    Serial.printf("FreeSleep POST to %s: %s\n", conn.host, payload);
 
-    const char* side = bedSideRight ? "right" : "left";
+    int httpCode = sendFreeSleepRequest(conn, op, payload);
+    finishFreeSleepRequest(conn, httpCode);
 
-    // Fetch bed temperature and power state
-    if (fetchFreeSleepTemperature(bedTargetIP, side, temp, isOn)) {
-        anySuccess = true;
-        if (bedPowerOn != isOn) {
-            bedPowerOn = isOn;
-            Serial.printf("Bed power state changed: %s\n", bedPowerOn ? "ON" : "OFF");
-            needsRedraw = true;
-        }
-        if (allowTempSync && abs(bedSetpoint - temp) > 0.1f) {
-            bedSetpoint = temp;
-            Serial.printf("Bed temperature synced: %.1f°C\n", bedSetpoint);
-            needsRedraw = true;
-        }
+    bool success = httpCode == HTTP_CODE_NO_CONTENT || httpCode == HTTP_CODE_OK;
+    if (!success) {
+        Serial.printf("FreeSleep POST %s failed: %d\n", conn.host, httpCode);
     }
+    recordFreeSleepResult(conn, success);
+    return success;
+}
 
-    // Fetch pillow temperature and power state
-    if (fetchFreeSleepTemperature(pillowTargetIP, side, temp, isOn)) {
-        anySuccess = true;
-        if (pillowPowerOn != isOn) {
-            pillowPowerOn = isOn;
-            Serial.printf("Pillow power state changed: %s\n", pillowPowerOn ? "ON" : "OFF");
-            needsRedraw = true;
-        }
-        if (allowTempSync && abs(pillowSetpoint - temp) > 0.1f) {
-            pillowSetpoint = temp;
-            Serial.printf("Pillow temperature synced: %.1f°C\n", pillowSetpoint);
-            needsRedraw = true;
+// POST every batched write - one per controller, all at once - then report the result
+// to each zone that was waiting on it. With streams open, whatever they delivered while the
+// POSTs were out is applied before the writes are acknowledged, so an event the pod sent
+// before taking the write is stamped older than it and can't undo it.
+void flushFreeSleepWrites(FreeSleepWriteBatch* batches, const FreeSleepCommand* subscription) {
+    freeSleepCycle++;
+    FreeSleepConnection* conns[MAX_ZONES] = {};
+    EventBits_t jobs = 0;
+    unsigned long deadline = millis() + FREESLEEP_TIMEOUT_MS;
+    for (int i = 0; i < MAX_ZONES; i++) {
+        FreeSleepWriteBatch& batch = batches[i];
+        if (!batch.used) continue;
+
+        FreeSleepConnection& conn = acquireFreeSleepConnection(IPAddress(batch.ip));
+        conns[i] = &conn;
+        if (conn.busy) continue;  // Still finishing a late job - the outbox retries this one
+        freeSleepBreakerAllows(conn, true);
+        conn.job.type = FS_JOB_WRITE;
+        conn.job.batch = &batch;
+        jobs |= startFreeSleepJob(conn, deadline);
+    }
+    EventBits_t done = waitFreeSleepJobs(jobs, deadline);
+    if (jobs && subscription) drainFreeSleepStreams(*subscription);
+
+    for (int i = 0; i < MAX_ZONES; i++) {
+        FreeSleepWriteBatch& batch = batches[i];
+        if (!batch.used) continue;
+
+        bool success = (done & freeSleepJobBit(*conns[i])) && conns[i]->job.success;
+        for (int zone = 0; zone < MAX_ZONES; zone++) {
+            if (!(batch.zoneMask & (1 << zone))) continue;
+            FreeSleepEvent event = {};
+            event.type = FS_EVT_WRITE_RESULT;
+            event.zone = (FreeSleepZone)zone;
+            event.success = success;
+            event.sequence = batch.sequence[zone];
+            if (success) ackedSequence[zone] = max(ackedSequence[zone], batch.sequence[zone]);
+            postFreeSleepEvent(event);
         }
+        batch.used = false;
     }
+}
 
-    // Handle backoff logic
-    if (anySuccess) {
-        // Reset on success
-        if (consecutiveFailures > 0) {
-            Serial.printf("FreeSleep sync recovered after %d failures\n", consecutiveFailures);
-            consecutiveFailures = 0;
-            currentSyncInterval = FREESLEEP_SYNC_INTERVAL_MS;
-            skipUserUpdates = false;  // Re-enable user updates
+// Fetch each distinct controller once - all of them concurrently, against one shared
+// deadline - then read every zone's side from its controller's response. A controller
+// that hasn't answered by the deadline reports a failure; the others aren't held up by it.
+void runFreeSleepRefresh(const FreeSleepCommand& command) {
+    freeSleepCycle++;
+    FreeSleepConnection* source[MAX_ZONES] = {};
+    EventBits_t jobs = 0;
+    bool anySuccess = false;
+    unsigned long start = millis();
+    unsigned long deadline = start + FREESLEEP_TIMEOUT_MS;
+    uint32_t allocationsBefore = freeSleepAllocations;
+
+    // Every zone reads the configured side
+    const JsonDocument& filter = freeSleepStatusFilter(command.side);
+
+    for (int zone = 0; zone < MAX_ZONES; zone++) {
+        if (!command.ip[zone]) continue;  // Zone not in use or not configured
+
+        // Zones on the same pod share one request
+        FreeSleepConnection& conn = acquireFreeSleepConnection(IPAddress(command.ip[zone]));
+        source[zone] = &conn;
+        if ((jobs & freeSleepJobBit(conn)) || conn.busy) continue;
+
+        conn.job.type = FS_JOB_STATUS;
+        conn.job.filter = &filter;
+        if (freeSleepBreakerAllows(conn, false)) {
+            jobs |= startFreeSleepJob(conn, deadline);
+        }
+    }
+    EventBits_t done = waitFreeSleepJobs(jobs, deadline);
+
+    for (int zone = 0; zone < MAX_ZONES; zone++) {
+        if (!source[zone]) continue;
+        const FreeSleepJob& job = source[zone]->job;
+
+        FreeSleepEvent status = {};
+        status.type = FS_EVT_STATUS;
+        status.zone = (FreeSleepZone)zone;
+        status.success = (done & freeSleepJobBit(*source[zone])) && job.success &&
+                         readFreeSleepSide(*job.doc, command.side, status.tempCelsius, status.isOn);
+        status.sequence = ackedSequence[zone];  // No writes run during a refresh
+        if (status.success) {
+            status.fingerprint = freeSleepFingerprint(status.tempCelsius, status.isOn);
+        }
+        anySuccess |= status.success;
+        postFreeSleepEvent(status);
+    }
+
+    FreeSleepEvent event = {};
+    event.type = FS_EVT_SYNC_COMPLETE;
+    event.success = anySuccess;
+    event.durationMs = millis() - start;
+    event.allocations = freeSleepAllocations - allocationsBefore;
+    postFreeSleepEvent(event);
+}
+
+// Toggle power for the currently active zone
+void toggleActivePower() {
+    FreeSleepZone zone = activeZone;
+    bool& powerOn = zonePowerOn(zone);
+
+    powerOn = !powerOn;
+    Serial.printf("Toggling %s power to %s\n", zoneName(zone), powerOn ? "ON" : "OFF");
+
+    // A setpoint still in its debounce window rides along in the same POST
+    bool sendTemperature = pendingFreeSleepUpdate && pendingFreeSleepZone == zone;
+    if (sendTemperature) pendingFreeSleepUpdate = false;
+    requestFreeSleepWrite(zone, sendTemperature, zoneSetpoint(zone), true, powerOn);
+
+    drawTemperatureUI();
+}
+
+// Periodic sync of temperature and power state from FreeSleep
+// Queues a refresh; the results arrive as events in processFreeSleepEvents()
+void syncFromFreeSleep() {
+    FreeSleepCommand command = {};
+    command.type = FS_CMD_REFRESH;
+    command.side = activeSide();
+    for (int zone = 0; zone < zoneCount; zone++) {
+        if (zoneControllerShadowed((FreeSleepZone)zone)) continue;
+        command.ip[zone] = zoneTargetIP((FreeSleepZone)zone);
+    }
+
+    if (submitFreeSleepCommand(command)) {
+        syncInFlight = true;
+        syncJitterPct = random(-FREESLEEP_SYNC_JITTER_PCT, FREESLEEP_SYNC_JITTER_PCT + 1);
+        memcpy(syncedTargetIP, command.ip, sizeof(syncedTargetIP));
+        syncedSide = command.side;
+    }
+}
+
+// Polling policy - re-evaluated every loop, so waking the dial shortens the wait immediately
+unsigned long freeSleepSyncInterval() {
+    unsigned long interval;
+    if (!isDimmed && millis() - lastActivityTime < FREESLEEP_ACTIVE_WINDOW_MS) {
+        interval = FREESLEEP_SYNC_INTERVAL_MS;
+    } else if (!isDimmed) {
+        interval = FREESLEEP_IDLE_SYNC_MS;
+    } else if (isNightTime()) {
+        interval = FREESLEEP_NIGHT_SYNC_MS;
+    } else {
+        interval = FREESLEEP_DIMMED_SYNC_MS;
+    }
+
+    // A slow pod (or slow WiFi) gets proportionally fewer requests
+    interval = max(interval, syncLatencyMs * FREESLEEP_LATENCY_FACTOR);
+
+    return interval + (long)interval * syncJitterPct / 100;
+}
+
+// True if the IPs or side have changed since the last refresh told the task what to subscribe to
+bool freeSleepTargetsChanged() {
+    if (syncedSide != activeSide()) return true;
+    for (int zone = 0; zone < MAX_ZONES; zone++) {
+        uint32_t ip = zone < zoneCount ? (uint32_t)zoneTargetIP((FreeSleepZone)zone) : 0;
+        if (syncedTargetIP[zone] != ip) return true;
+    }
+    return false;
+}
+
+// ==================== FreeSleep Client Task ====================
+
+// Count an allocation if it was made on the FreeSleep task or one of its workers
+void countFreeSleepAllocation() {
+    if (!freeSleepTaskHandle) return;  // Not started yet - and nothing to compare against
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    bool counted = task == freeSleepTaskHandle;
+    for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS && !counted; i++) {
+        counted = task == freeSleepConnections[i].worker;
+    }
+    if (counted) __atomic_fetch_add(&freeSleepAllocations, 1, __ATOMIC_RELAXED);
+}
+
+// The linker routes every malloc, calloc and realloc here (-Wl,--wrap in platformio.ini)
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    countFreeSleepAllocation();
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    countFreeSleepAllocation();
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    countFreeSleepAllocation();
+    return __real_realloc(ptr, size);
+}
+}
+
+void startFreeSleepTask() {
+    freeSleepCommandQueue = xQueueCreate(FREESLEEP_COMMAND_QUEUE_LEN, sizeof(FreeSleepCommand));
+    freeSleepEventQueue = xQueueCreate(FREESLEEP_EVENT_QUEUE_LEN, sizeof(FreeSleepEvent));
+
+    freeSleepJobsDone = xEventGroupCreate();
+
+    for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "freesleep-%d", i);
+        xTaskCreatePinnedToCore(freeSleepWorker, name, FREESLEEP_WORKER_STACK, &freeSleepConnections[i], 1,
+                                &freeSleepConnections[i].worker, FREESLEEP_TASK_CORE);
+    }
+    xTaskCreatePinnedToCore(freeSleepTask, "freesleep", FREESLEEP_TASK_STACK, nullptr, 1,
+                            &freeSleepTaskHandle, FREESLEEP_TASK_CORE);
+    // Below the FreeSleep task, so a browse only ever uses time it leaves idle
+    xTaskCreatePinnedToCore(freeSleepDiscoveryTask, "discovery", FREESLEEP_WORKER_STACK, nullptr,
+                            tskIDLE_PRIORITY, &freeSleepDiscoveryTaskHandle, FREESLEEP_TASK_CORE);
+    Serial.printf("FreeSleep task started on core %d with %d workers\n", FREESLEEP_TASK_CORE,
+                  FREESLEEP_MAX_CONNECTIONS);
+}
+
+// One per connection slot. Sleeps until handed a job, runs it on its own socket, reports done.
+void freeSleepWorker(void* param) {
+    FreeSleepConnection& conn = *(FreeSleepConnection*)param;
+    EventBits_t bit = freeSleepJobBit(conn);
+    JsonDocument doc(&conn.arena);  // Parsed statuses never leave the connection's arena
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        FreeSleepJob& job = conn.job;
+        conn.deadline = job.deadline;
+        if (job.type == FS_JOB_STATUS) {
+            // Release the last status, then rewind the arena under it
+            doc.clear();
+            conn.arena.reset();
+            job.doc = &doc;
+            job.success = fetchFreeSleepStatus(conn, *job.filter, doc);
+        } else if (job.type == FS_JOB_WRITE) {
+            job.success = postFreeSleepWrite(conn, *job.batch);
+        } else {
+            probeFreeSleepController(conn, job.host, job.probe);
+            job.success = job.probe.httpCode == HTTP_CODE_OK;
+        }
+        conn.busy = false;
+        xEventGroupSetBits(freeSleepJobsDone, bit);
+    }
+}
+
+EventBits_t freeSleepJobBit(const FreeSleepConnection& conn) {
+    return 1 << (&conn - freeSleepConnections);
+}
+
+// Wake the connection's worker on the job already filled in; returns its bit for waitFreeSleepJobs()
+EventBits_t startFreeSleepJob(FreeSleepConnection& conn, unsigned long deadline) {
+    EventBits_t bit = freeSleepJobBit(conn);
+    xEventGroupClearBits(freeSleepJobsDone, bit);  // A late finish from an earlier cycle doesn't count
+    conn.job.deadline = deadline;
+    conn.job.success = false;
+    conn.busy = true;
+    xTaskNotifyGive(conn.worker);
+    return bit;
+}
+
+// Block the FreeSleep task until every started job has finished, or until the shared deadline
+// (plus a short grace) has passed. Returns the jobs that finished; a straggler keeps its
+// connection busy until its worker gives up, and its result is dropped.
+EventBits_t waitFreeSleepJobs(EventBits_t jobs, unsigned long deadline) {
+    if (!jobs) return 0;
+    long wait = max((long)(deadline - millis()) + FREESLEEP_DEADLINE_GRACE_MS, 0L);
+    EventBits_t done = xEventGroupWaitBits(freeSleepJobsDone, jobs, pdFALSE, pdTRUE, pdMS_TO_TICKS(wait)) & jobs;
+    xEventGroupClearBits(freeSleepJobsDone, done);
+    return done;
+}
+
+// Runs on core 0. Executes commands one at a time, fanning each one out to the
+// controller workers; blocking here only delays other FreeSleep commands, never the UI.
+void freeSleepTask(void* param) {
+    FreeSleepCommand command;
+    FreeSleepCommand refresh;
+    FreeSleepCommand subscription;  // Last refresh - says which controllers and side to stream
+    bool subscribed = false;
+    FreeSleepWriteBatch batches[MAX_ZONES] = {};
+
+    for (;;) {
+        // Wake regularly to read the streams once subscribed, and for the discovery schedule
+        TickType_t wait = subscribed ? FREESLEEP_STREAM_POLL_TICKS : pdMS_TO_TICKS(1000);
+        if (xQueueReceive(freeSleepCommandQueue, &command, wait) == pdTRUE) {
+            // Drain everything already queued so writes to the same controller share one POST
+            bool refreshRequested = false;
+            bool diagnoseRequested = false;
+            do {
+                if (command.type == FS_CMD_WRITE) {
+                    queueFreeSleepWrite(batches, command);
+                } else if (command.type == FS_CMD_DISCOVER) {
+                    discoveryRequested = true;
+                    lastDiscovery = 0;  // Explicit request skips the rate limit
+                    xTaskNotifyGive(freeSleepDiscoveryTaskHandle);
+                } else if (command.type == FS_CMD_DIAGNOSE) {
+                    diagnoseRequested = true;
+                } else {
+                    refresh = command;
+                    refreshRequested = true;
+                }
+            } while (xQueueReceive(freeSleepCommandQueue, &command, 0) == pdTRUE);
+
+            // Writes go first so a refresh in the same batch reads back the new state
+            flushFreeSleepWrites(batches, subscribed ? &subscription : nullptr);
+            if (refreshRequested) {
+                runFreeSleepRefresh(refresh);
+                subscription = refresh;
+                subscribed = true;
+            }
+            if (diagnoseRequested) runFreeSleepDiagnostics();
+        }
+
+        if (subscribed) serviceFreeSleepStreams(subscription);
+
+        // A worker records into its slot's stats mid-job, so a busy slot is cleared on a later pass.
+        // Only this task starts jobs, so an idle slot stays idle until the memset is done.
+        if (freeSleepStatsResetRequested) {
+            for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS; i++) freeSleepConnections[i].opsResetPending = true;
+            freeSleepStatsResetRequested = false;
+        }
+        for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS; i++) {
+            FreeSleepConnection& conn = freeSleepConnections[i];
+            if (!conn.opsResetPending || conn.busy) continue;
+            memset(conn.ops, 0, sizeof(conn.ops));
+            conn.opsResetPending = false;
+        }
+    }
+}
+
+// Probe each distinct controller in freeSleepDiagnostics on its worker, all at once, then
+// hand the results over to GET /api/debug/test-freesleep
+void runFreeSleepDiagnostics() {
+    freeSleepCycle++;
+    FreeSleepDiagnostics& diagnostics = freeSleepDiagnostics;
+    FreeSleepConnection* source[MAX_ZONES] = {};
+    EventBits_t jobs = 0;
+    unsigned long start = millis();
+    unsigned long deadline = start + FREESLEEP_TIMEOUT_MS;
+
+    for (int zone = 0; zone < MAX_ZONES && wifiConnected; zone++) {
+        if (!diagnostics.ip[zone]) continue;
+
+        FreeSleepConnection& conn = acquireFreeSleepConnection(IPAddress(diagnostics.ip[zone]));
+        source[zone] = &conn;
+        if ((jobs & freeSleepJobBit(conn)) || conn.busy) continue;
+
+        // Probes ignore the breaker - a controller that's down is exactly what's being looked at
+        conn.job.type = FS_JOB_PROBE;
+        conn.job.host = diagnostics.host[zone];
+        jobs |= startFreeSleepJob(conn, deadline);
+    }
+    EventBits_t done = waitFreeSleepJobs(jobs, deadline);
+
+    for (int zone = 0; zone < MAX_ZONES; zone++) {
+        if (!source[zone]) continue;
+        FreeSleepProbe& probe = diagnostics.probes[zone];
+        if (done & freeSleepJobBit(*source[zone])) {
+            probe = source[zone]->job.probe;
+        } else {
+            probe = {};
+            probe.httpCode = HTTPC_ERROR_READ_TIMEOUT;  // Busy or past the deadline
         }
+    }
+    diagnostics.rssi = WiFi.RSSI();
+    diagnostics.channel = WiFi.channel();
+    diagnostics.durationMs = millis() - start;
+    diagnostics.finishedAt = millis();
+    freeSleepDiagnosticsState = DIAGNOSTICS_DONE;  // Hands the results to the web server
+}
+
+// Time every phase of one status GET on a fresh socket. Read-only, and kept out of the
+// breaker and the request histograms - it reports on the path, it isn't part of the traffic.
+// The finished socket is left to the pool.
+void probeFreeSleepController(FreeSleepConnection& conn, char* host, FreeSleepProbe& probe) {
+    unsigned long start = micros();
+    probe = {};
+    probe.httpCode = HTTPC_ERROR_CONNECTION_REFUSED;
+
+    // Look the identity up as discovery would, for the timing only (at most half the budget) -
+    // the request still goes to the address the dial actually uses
+    long remaining = (long)(conn.deadline - millis());
+    if (host[0] && mdnsStarted && remaining > 0) {
+        IPAddress resolved = MDNS.queryHost(host, remaining / 2);
+        probe.dnsMicros = micros() - start;
+        probe.resolvedIP = (uint32_t)resolved;
+    }
+
+    conn.client.stop();
+    conn.requests = 0;
+    remaining = (long)(conn.deadline - millis());
+    unsigned long phase = micros();
+    if (remaining <= 0 || !conn.client.connect(conn.ip, FREESLEEP_PORT, (int32_t)remaining)) {
+        probe.totalMicros = micros() - start;
+        return;
+    }
+    conn.client.setNoDelay(true);
+    probe.connectMicros = micros() - phase;
+
+    char request[FREESLEEP_REQUEST_MAX];
+    int length = formatFreeSleepRequest(conn, nullptr, request, sizeof(request));
+    phase = micros();
+    if (conn.client.write((const uint8_t*)request, length) != (size_t)length) {
+        probe.httpCode = HTTPC_ERROR_SEND_HEADER_FAILED;
     } else {
-        // Exponential backoff on failure
-        consecutiveFailures++;
-        currentSyncInterval = min(currentSyncInterval * 2, MAX_SYNC_INTERVAL_MS);
-        Serial.printf("FreeSleep sync failed (%d consecutive), backing off to %lums\n",
-                     consecutiveFailures, currentSyncInterval);
-        // After 3 failures, stop trying to send user updates (prevents blocking)
-        if (consecutiveFailures >= 3) {
-            skipUserUpdates = true;
+        probe.sendMicros = micros() - phase;
+
+        // Time to first byte, at the 1ms resolution of the wait
+        phase = micros();
+        while (!conn.client.available() && conn.client.connected() && (long)(millis() - conn.deadline) < 0) {
+            delay(1);
+        }
+        if (conn.client.available()) probe.firstByteMicros = micros() - phase;
+
+        probe.httpCode = readFreeSleepResponseHead(conn);
+        if (probe.httpCode > 0) {
+            while (readFreeSleepBody(conn) >= 0) probe.bodyBytes++;
+        }
+    }
+    probe.totalMicros = micros() - start;
+
+    if (probe.httpCode <= 0 || !conn.keepAlive) {
+        conn.client.stop();
+    } else {
+        conn.requests++;
+    }
+}
+
+bool freeSleepDiscoveryDue() {
+    if (!wifiConnected) return false;
+    if (lastDiscovery == 0) return true;
+    unsigned long since = millis() - lastDiscovery;
+    return since >= FREESLEEP_DISCOVERY_INTERVAL_MS ||
+           (discoveryRequested && since >= FREESLEEP_DISCOVERY_MIN_GAP_MS);
+}
+
+// Browse on schedule, or as soon as a browse is requested (subject to the rate limit)
+void freeSleepDiscoveryTask(void* param) {
+    for (;;) {
+        if (freeSleepDiscoveryDue()) runFreeSleepDiscovery();
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+    }
+}
+
+// Browse for _freesleep._tcp and report every answer (blocks the discovery task for the query)
+void runFreeSleepDiscovery() {
+    lastDiscovery = millis();
+    discoveryRequested = false;
+
+    if (!mdnsStarted) {
+        mdnsStarted = MDNS.begin(MDNS_HOSTNAME);
+        if (!mdnsStarted) {
+            Serial.println("mDNS start failed - discovery disabled until next attempt");
+            return;
+        }
+    }
+
+    int found = MDNS.queryService(FREESLEEP_MDNS_SERVICE, "tcp");
+    Serial.printf("FreeSleep discovery: %d controller(s)\n", max(found, 0));
+
+    for (int i = 0; i < found; i++) {
+        FreeSleepEvent event = {};
+        event.type = FS_EVT_CONTROLLER_FOUND;
+        event.ip = (uint32_t)MDNS.IP(i);
+        event.port = MDNS.port(i);
+        strlcpy(event.name, MDNS.hostname(i).c_str(), sizeof(event.name));
+        postFreeSleepEvent(event);
+    }
+}
+
+// Keep one event stream open per distinct controller and apply whatever arrived on it
+void serviceFreeSleepStreams(const FreeSleepCommand& target) {
+    bool allLive = wifiConnected;
+
+    for (int zone = 0; zone < MAX_ZONES && wifiConnected; zone++) {
+        if (!target.ip[zone]) continue;
+        bool seen = false;
+        for (int other = 0; other < zone; other++) {
+            seen |= target.ip[other] == target.ip[zone];
+        }
+        if (seen) continue;
+
+        FreeSleepStream& stream = acquireFreeSleepStream(IPAddress(target.ip[zone]), target);
+        // No slot yet means no request has failed there
+        const FreeSleepConnection* conn = findFreeSleepConnection(stream.ip);
+        bool breakerClosed = !conn || conn->breaker == BREAKER_CLOSED;
+        if (!stream.connected && breakerClosed && (stream.lastAttempt == 0 ||
+                                                   millis() - stream.lastAttempt >= FREESLEEP_STREAM_RETRY_MS)) {
+            openFreeSleepStream(stream);
+        }
+        if (stream.connected) {
+            readFreeSleepStream(stream, target);
+        }
+        allLive &= stream.connected;
+    }
+
+    if (allLive != freeSleepPushLive) {
+        Serial.println(allLive ? "FreeSleep push live - polling relaxed" : "FreeSleep push down - polling");
+    }
+    freeSleepPushLive = allLive;
+}
+
+// Find the stream slot for a controller, reusing a free slot or one whose controller is no longer targeted
+FreeSleepStream& acquireFreeSleepStream(IPAddress ip, const FreeSleepCommand& target) {
+    FreeSleepStream* slot = nullptr;
+    for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS; i++) {
+        FreeSleepStream& stream = freeSleepStreams[i];
+        if (stream.assigned && stream.ip == ip) return stream;
+
+        bool targeted = false;
+        for (int zone = 0; zone < MAX_ZONES; zone++) {
+            targeted |= stream.assigned && target.ip[zone] == (uint32_t)stream.ip;
+        }
+        if (!slot && !targeted) slot = &stream;
+    }
+    if (!slot) slot = &freeSleepStreams[0];  // Can't happen: one slot per zone
+
+    if (slot->connected) closeFreeSleepStream(*slot, "controller changed");
+    slot->assigned = true;
+    slot->ip = ip;
+    snprintf(slot->host, sizeof(slot->host), "%u.%u.%u.%u:%u", ip[0], ip[1], ip[2], ip[3], FREESLEEP_PORT);
+    slot->lastAttempt = 0;
+    return *slot;
+}
+
+// Connect and read the response head within FREESLEEP_STREAM_OPEN_MS, with the same
+// line reader as requests; events are then read only as they arrive
+bool openFreeSleepStream(FreeSleepStream& stream) {
+    stream.lastAttempt = millis();
+    unsigned long deadline = stream.lastAttempt + FREESLEEP_STREAM_OPEN_MS;
+    if (!stream.client.connect(stream.ip, FREESLEEP_PORT, (int32_t)FREESLEEP_STREAM_OPEN_MS)) {
+        return false;
+    }
+
+    // HTTP/1.0 so the server can't answer with chunked encoding - the body is then the raw event stream
+    char request[FREESLEEP_REQUEST_MAX];
+    int length = snprintf(request, sizeof(request), "GET %s HTTP/1.0\r\nHost: %s\r\nAccept: text/event-stream\r\n\r\n",
+                          FREESLEEP_STREAM_PATH, stream.host);
+
+    char line[FREESLEEP_LINE_MAX] = "";
+    int httpCode = 0;
+    bool ok = stream.client.write((const uint8_t*)request, length) == (size_t)length &&
+              readFreeSleepLine(stream.client, deadline, line, sizeof(line)) &&
+              sscanf(line, "HTTP/1.%*d %d", &httpCode) == 1 && httpCode == HTTP_CODE_OK;
+    if (!ok) {
+        Serial.printf("FreeSleep %s has no event stream (%s) - polling\n", stream.host,
+                     line[0] ? line : "no response");
+        stream.client.stop();
+        return false;
+    }
+
+    // Skip the response headers
+    do {
+        if (!readFreeSleepLine(stream.client, deadline, line, sizeof(line))) {
+            Serial.printf("FreeSleep %s event stream head incomplete - polling\n", stream.host);
+            stream.client.stop();
+            return false;
+        }
+    } while (line[0]);
+
+    stream.connected = true;
+    stream.lastActivity = millis();
+    stream.dataLength = 0;
+    stream.length = 0;
+    stream.overflow = false;
+    stream.connects++;
+    Serial.printf("FreeSleep event stream open: %s\n", stream.host);
+    return true;
+}
+
+void closeFreeSleepStream(FreeSleepStream& stream, const char* reason) {
+    Serial.printf("FreeSleep event stream closed (%s): %s\n", reason, stream.host);
+    stream.client.stop();
+    stream.connected = false;
+}
+
+// Read every open stream without opening any, so events already received are stamped now
+void drainFreeSleepStreams(const FreeSleepCommand& target) {
+    for (int i = 0; i < FREESLEEP_MAX_CONNECTIONS; i++) {
+        if (freeSleepStreams[i].connected) readFreeSleepStream(freeSleepStreams[i], target);
+    }
+}
+
+// Consume whatever bytes have arrived, dispatching each complete SSE event
+void readFreeSleepStream(FreeSleepStream& stream, const FreeSleepCommand& target) {
+    unsigned long now = millis();
+
+    while (stream.client.available()) {
+        int c = stream.client.read();
+        stream.lastActivity = now;
+        if (c == '\r') continue;
+
+        if (c != '\n') {
+            if (stream.length < sizeof(stream.event)) {
+                stream.event[stream.length++] = c;
+            } else {
+                stream.overflow = true;
+            }
+            continue;
         }
+
+        // A blank line ends the event; "data:" lines make up its payload. Comments
+        // (":" keep-alives) and other fields only count as activity.
+        char* line = stream.event + stream.dataLength;
+        size_t lineLength = stream.length - stream.dataLength;
+        if (lineLength == 0) {
+            if (stream.overflow) {
+                Serial.printf("FreeSleep %s stream event over %u bytes - dropped\n", stream.host,
+                             (unsigned)FREESLEEP_STREAM_MAX_EVENT);
+            } else if (stream.dataLength > 0) {
+                dispatchFreeSleepStreamEvent(stream, target);
+            }
+            stream.dataLength = 0;
+            stream.overflow = false;
+        } else if (lineLength >= 5 && strncmp(line, "data:", 5) == 0) {
+            size_t start = (lineLength > 5 && line[5] == ' ') ? 6 : 5;
+            // Data lines are joined with a newline, written over the line's own field name
+            if (stream.dataLength > 0) stream.event[stream.dataLength++] = '\n';
+            memmove(stream.event + stream.dataLength, line + start, lineLength - start);
+            stream.dataLength += lineLength - start;
+        }
+        stream.length = stream.dataLength;
     }
 
-    // Only redraw if something actually changed
-    if (needsRedraw) {
+    if (!stream.client.connected()) {
+        closeFreeSleepStream(stream, "disconnected");
+    } else if (now - stream.lastActivity >= FREESLEEP_STREAM_IDLE_MS) {
+        closeFreeSleepStream(stream, "idle");
+    }
+}
+
+// An event carries a deviceStatus body; report it for every zone on that controller
+void dispatchFreeSleepStreamEvent(FreeSleepStream& stream, const FreeSleepCommand& target) {
+    freeSleepStreamArena.reset();
+    JsonDocument doc(&freeSleepStreamArena);  // Rewound for every event, like a worker's
+    DeserializationError error = deserializeJson(doc, (const char*)stream.event, stream.dataLength,
+                                                 DeserializationOption::Filter(freeSleepStatusFilter(target.side)));
+    if (error) {
+        Serial.printf("FreeSleep stream event parse failed: %s\n", error.c_str());
+        return;
+    }
+
+    stream.events++;
+    for (int zone = 0; zone < MAX_ZONES; zone++) {
+        if (target.ip[zone] != (uint32_t)stream.ip) continue;
+
+        FreeSleepEvent status = {};
+        status.type = FS_EVT_STATUS;
+        status.zone = (FreeSleepZone)zone;
+        status.success = readFreeSleepSide(doc, target.side, status.tempCelsius, status.isOn);
+        if (!status.success) continue;  // Partial update without this side's fields
+        status.fingerprint = freeSleepFingerprint(status.tempCelsius, status.isOn);
+        status.sequence = ackedSequence[zone];  // Streams are drained before each ack, so this is as of receipt
+        postFreeSleepEvent(status);
+    }
+}
+
+void postFreeSleepEvent(const FreeSleepEvent& event) {
+    // The UI drains the queue every loop; if it's somehow full, wait briefly rather than drop a result
+    if (xQueueSend(freeSleepEventQueue, &event, pdMS_TO_TICKS(100)) != pdTRUE) {
+        Serial.println("FreeSleep event queue full - result dropped");
+    }
+}
+
+// Never blocks: a full queue drops the command (the next sync or change resends state)
+bool submitFreeSleepCommand(const FreeSleepCommand& command) {
+    if (!freeSleepCommandQueue || xQueueSend(freeSleepCommandQueue, &command, 0) != pdTRUE) {
+        Serial.println("FreeSleep command queue full - command dropped");
+        return false;
+    }
+    return true;
+}
+
+void requestFreeSleepTemperature(FreeSleepZone zone, float tempCelsius) {
+    requestFreeSleepWrite(zone, true, tempCelsius, false, false);
+}
+
+// Write one side of the zone's pod. The configured side goes through the outbox as usual;
+// the other side is a one-off write (sequence 0) that nothing waits on or reconciles, since
+// the dial never reads that side back.
+void requestFreeSleepSideTemperature(FreeSleepZone zone, const char* side, float tempCelsius) {
+    if (strcmp(side, activeSide()) == 0) {
+        requestFreeSleepTemperature(zone, tempCelsius);
+        return;
+    }
+    if (!wifiConnected || !(uint32_t)zoneTargetIP(zone) || zoneControllerShadowed(zone)) return;
+
+    FreeSleepCommand command = {};
+    command.type = FS_CMD_WRITE;
+    command.zone = zone;
+    command.ip[zone] = zoneTargetIP(zone);
+    command.side = side;
+    command.setTemperature = true;
+    command.tempCelsius = tempCelsius;
+    submitFreeSleepCommand(command);
+}
+
+// Queue a write in the zone's outbox entry; it goes out on the next serviceOutbox()
+void requestFreeSleepWrite(FreeSleepZone zone, bool setTemperature, float tempCelsius, bool setPower, bool powerOn) {
+    // Local state now differs from the last applied status; the next poll must be applied
+    zoneFingerprint[zone] = 0;
+
+    OutboxEntry& entry = outbox[zone];
+
+    // Nothing to send if the pod already holds this value in whole °F - unless a different
+    // one is still on its way there
+    if (setTemperature && freeSleepTempF(tempCelsius) == podTempF[zone] && !(entry.inFlight && entry.sentTempF)) {
+        setTemperature = false;
+        temperatureVersion[zone] = podTempSequence[zone];  // Dial changes since then are settled
+        syncStats[zone].suppressed++;
+        if (entry.hasTemperature) {
+            entry.hasTemperature = false;  // A queued value it replaces is moot too
+            if (entry.persisted) saveOutbox();
+        }
+        if (!setPower) return;
+    }
+
+    if (!outboxPending(zone)) {
+        entry.queuedAt = millis();
+        entry.retryMs = 0;
+        entry.attempts = 0;
+    }
+    if (setTemperature) {
+        entry.hasTemperature = true;
+        entry.tempCelsius = tempCelsius;
+    }
+    if (setPower) {
+        entry.hasPower = true;
+        entry.powerOn = powerOn;
+    }
+    entry.sequence = markLocalChange(zone, setTemperature, setPower);
+    entry.nextAttempt = millis();  // A fresh change from the user goes out right away
+    if (entry.persisted) saveOutbox();
+}
+
+// Give a local change the next sequence number; the changed fields now wait for the pod to catch up
+uint32_t markLocalChange(FreeSleepZone zone, bool temperature, bool power) {
+    localSequence++;
+    if (temperature) temperatureVersion[zone] = localSequence;
+    if (power) powerVersion[zone] = localSequence;
+    return localSequence;
+}
+
+// The active setpoint changed on the dial - send it once the user stops turning
+void scheduleFreeSleepUpdate() {
+    unsigned long now = millis();
+    unsigned long gap = now - lastSetpointChangeTime;
+    if (setpointBurstChanges > 0 && gap < FREESLEEP_DEBOUNCE_MAX_MS) {
+        setpointChangeGapMs = setpointBurstChanges > 1 ? (setpointChangeGapMs + gap) / 2 : gap;
+        setpointBurstChanges++;
+    } else {
+        setpointBurstChanges = 1;  // After a pause a change starts a new burst
+    }
+
+    if (pendingFreeSleepUpdate && pendingFreeSleepZone != activeZone) sendPendingFreeSleepUpdate();
+    markLocalChange(activeZone, true, false);
+    lastSetpointChangeTime = now;
+    pendingFreeSleepUpdate = true;
+    pendingFreeSleepZone = activeZone;
+}
+
+// Send the debounced setpoint to the zone it was turned on
+void sendPendingFreeSleepUpdate() {
+    FreeSleepZone zone = pendingFreeSleepZone;
+    pendingFreeSleepUpdate = false;
+    zoneFingerprint[zone] = 0;  // Local setpoint diverged - apply the next poll even if unchanged
+    requestFreeSleepTemperature(zone, zoneSetpoint(zone));
+}
+
+// How long after the last change the pending setpoint waits before it's sent
+unsigned long freeSleepDebounceWindow() {
+    // Single detent - the budget less the write's round trip (the full budget until one is measured)
+    unsigned long single = FREESLEEP_DEBOUNCE_MS -
+                           min(writeLatencyMs, FREESLEEP_DEBOUNCE_MS - FREESLEEP_DEBOUNCE_MIN_MS);
+    if (setpointBurstChanges <= 1) return single;
+
+    // Spinning - ride out a pause between turns rather than write mid-spin.
+    // Stepping - wait half as long again as the user's own rhythm.
+    unsigned long window = setpointChangeGapMs < FREESLEEP_SPIN_GAP_MS
+                           ? FREESLEEP_DEBOUNCE_MS
+                           : constrain(setpointChangeGapMs * 3 / 2, single, FREESLEEP_DEBOUNCE_MS);
+
+    // Within a burst, never send faster than the pod completes writes
+    return min(max(window, writeLatencyMs), FREESLEEP_DEBOUNCE_MAX_MS);
+}
+
+// Forget a zone's unsent writes. Its fields fall back to the last acknowledged version, so the
+// next status is applied instead of being ignored as older than a change that won't be sent.
+void dropOutboxEntry(FreeSleepZone zone) {
+    if (pendingFreeSleepZone == zone) pendingFreeSleepUpdate = false;  // Nor will a debounced one
+    outbox[zone] = {};
+    temperatureVersion[zone] = ackedSequence[zone];
+    powerVersion[zone] = ackedSequence[zone];
+    zoneFingerprint[zone] = 0;
+}
+
+bool outboxPending(FreeSleepZone zone) {
+    return outbox[zone].hasTemperature || outbox[zone].hasPower;
+}
+
+// Hand due outbox entries to the FreeSleep task - at most one in flight per zone
+void serviceOutbox() {
+    unsigned long now = millis();
+
+    for (int i = 0; i < zoneCount; i++) {
+        FreeSleepZone zone = (FreeSleepZone)i;
+        OutboxEntry& entry = outbox[zone];
+        if (!outboxPending(zone)) continue;
+
+        if (entry.inFlight) {
+            if (now - entry.sentAt < OUTBOX_RESULT_TIMEOUT_MS) continue;
+            Serial.printf("%s outbox result lost - retrying\n", zoneName(zone));
+            entry.inFlight = false;
+        }
+        if (!wifiConnected || (long)(now - entry.nextAttempt) < 0) continue;
+        if (zoneControllerShadowed(zone)) {
+            Serial.printf("%s shares %s's controller - write dropped\n", zoneName(zone),
+                         zoneName(zoneOnController(zoneTargetIP(zone), zone)));
+            dropOutboxEntry(zone);
+            saveOutbox();
+            continue;
+        }
+
+        FreeSleepCommand command = {};
+        command.type = FS_CMD_WRITE;
+        command.zone = zone;
+        command.ip[zone] = zoneTargetIP(zone);
+        command.side = activeSide();
+        command.setTemperature = entry.hasTemperature;
+        command.tempCelsius = entry.tempCelsius;
+        command.setPower = entry.hasPower;
+        command.powerOn = entry.powerOn;
+        command.sequence = entry.sequence;
+
+        if (submitFreeSleepCommand(command)) {
+            entry.inFlight = true;
+            entry.sentAt = now;
+            entry.sentTempF = entry.hasTemperature ? freeSleepTempF(entry.tempCelsius) : 0;
+            entry.attempts++;
+        } else {
+            entry.nextAttempt = now + OUTBOX_RETRY_MIN_MS;
+        }
+    }
+}
+
+void handleOutboxResult(const FreeSleepEvent& event) {
+    OutboxEntry& entry = outbox[event.zone];
+    if (!entry.inFlight) return;
+    entry.inFlight = false;
+
+    if (event.success) {
+        unsigned long latency = millis() - entry.sentAt;
+        writeLatencyMs = writeLatencyMs ? (writeLatencyMs * 3 + latency) / 4 : latency;
+        if (entry.sentTempF) {
+            podTempF[event.zone] = entry.sentTempF;
+            podTempSequence[event.zone] = event.sequence;
+        }
+        if (event.sequence == entry.sequence) {
+            // Acknowledged and nothing newer queued - done
+            bool persisted = entry.persisted;
+            entry = {};
+            if (persisted) saveOutbox();
+        } else {
+            entry.nextAttempt = millis();  // Changed while in flight - send the newer value now
+        }
+        return;
+    }
+
+    entry.retryMs = entry.retryMs ? min(entry.retryMs * 2, OUTBOX_RETRY_MAX_MS) : OUTBOX_RETRY_MIN_MS;
+    entry.nextAttempt = millis() + entry.retryMs;
+    Serial.printf("FreeSleep %s write failed (attempt %d), retrying in %lums\n",
+                 zoneName(event.zone), entry.attempts, entry.retryMs);
+    if (!entry.persisted) saveOutbox();
+}
+
+// Write every pending entry to NVS, or clear the key when nothing is pending
+void saveOutbox() {
+    OutboxRecord records[MAX_ZONES] = {};
+    bool any = false;
+    for (int zone = 0; zone < MAX_ZONES; zone++) {
+        const OutboxEntry& entry = outbox[zone];
+        records[zone].hasTemperature = entry.hasTemperature;
+        records[zone].tempCelsius = entry.tempCelsius;
+        records[zone].hasPower = entry.hasPower;
+        records[zone].powerOn = entry.powerOn;
+        any |= outboxPending((FreeSleepZone)zone);
+    }
+
+    if (any) {
+        preferences.putBytes("outbox", records, sizeof(records));
+    } else {
+        preferences.remove("outbox");
+    }
+    for (int zone = 0; zone < MAX_ZONES; zone++) {
+        outbox[zone].persisted = any && outboxPending((FreeSleepZone)zone);
+    }
+}
+
+// Restore unacknowledged writes and show them locally - they're what the user last chose
+void loadOutbox() {
+    // Older firmware saved fewer zones - take whatever records there are
+    OutboxRecord records[MAX_ZONES] = {};
+    size_t length = preferences.getBytesLength("outbox");
+    if (length == 0 || length > sizeof(records) || length % sizeof(OutboxRecord) != 0) return;
+    preferences.getBytes("outbox", records, length);
+
+    for (int i = 0; i < zoneCount; i++) {
+        FreeSleepZone zone = (FreeSleepZone)i;
+        const OutboxRecord& record = records[zone];
+        OutboxEntry& entry = outbox[zone];
+        entry = {};
+        entry.hasTemperature = record.hasTemperature;
+        entry.tempCelsius = constrain(record.tempCelsius, TEMP_MIN, TEMP_MAX);
+        entry.hasPower = record.hasPower;
+        entry.powerOn = record.powerOn;
+        if (!outboxPending(zone)) continue;
+
+        entry.persisted = true;
+        entry.queuedAt = millis();
+        entry.sequence = markLocalChange(zone, entry.hasTemperature, entry.hasPower);
+        if (entry.hasTemperature) zoneSetpoint(zone) = entry.tempCelsius;
+        if (entry.hasPower) zonePowerOn(zone) = entry.powerOn;
+        Serial.printf("Restored pending %s write from NVS\n", zoneName(zone));
+    }
+}
+
+// Apply everything the FreeSleep task has reported since the last loop (UI thread)
+void processFreeSleepEvents() {
+    if (!freeSleepEventQueue) return;
+
+    FreeSleepEvent event;
+    bool needsRedraw = false;
+
+    while (xQueueReceive(freeSleepEventQueue, &event, 0) == pdTRUE) {
+        switch (event.type) {
+            case FS_EVT_STATUS: {
+                FreeSleepSyncStats& stats = syncStats[event.zone];
+                // The controller is answering again - replay anything waiting on a retry
+                OutboxEntry& pending = outbox[event.zone];
+                if (event.success && outboxPending(event.zone) && !pending.inFlight && pending.attempts > 0) {
+                    pending.nextAttempt = millis();
+                }
+                if (!event.success) {
+                    stats.failed++;
+                } else if (event.fingerprint == zoneFingerprint[event.zone]) {
+                    stats.unchanged++;  // Same as the last status we applied - nothing to do
+                } else {
+                    stats.changed++;
+                    needsRedraw |= applyFreeSleepStatus(event);
+                }
+                break;
+            }
+
+            case FS_EVT_SYNC_COMPLETE:
+                syncInFlight = false;  // Backoff is handled per controller by the task's breakers
+                refreshAllocations = event.allocations;
+                if (event.allocations) refreshesAllocating++;
+                // Failed refreshes mostly measure timeouts - leave those to the breakers
+                if (event.success) {
+                    syncLatencyMs = syncLatencyMs ? (syncLatencyMs * 3 + event.durationMs) / 4 : event.durationMs;
+                }
+                break;
+
+            case FS_EVT_WRITE_RESULT:
+                handleOutboxResult(event);
+                break;
+
+            case FS_EVT_CONTROLLER_FOUND:
+                handleControllerFound(event);
+                break;
+        }
+    }
+
+    // Only redraw if something actually changed, and only on the main screen
+    if (needsRedraw && !inSettingsMenu) {
         drawTemperatureUI();
     }
 }
+
+// Merge a fetched zone status into local state. Returns true if anything changed.
+bool applyFreeSleepStatus(const FreeSleepEvent& event) {
+    if (!event.success) return false;
+
+    bool changed = false;
+    const char* name = zoneName(event.zone);
+
+    // A field the user changed after the pod's last acknowledgement keeps the local value -
+    // this status was read before the pod knew about it
+    bool powerCurrent = event.sequence >= powerVersion[event.zone];
+    bool temperatureCurrent = event.sequence >= temperatureVersion[event.zone];
+
+    bool& powerOn = zonePowerOn(event.zone);
+    if (powerCurrent && powerOn != event.isOn) {
+        powerOn = event.isOn;
+        Serial.printf("%s power state changed: %s\n", name, powerOn ? "ON" : "OFF");
+        changed = true;
+    }
+
+    // Compare in the pod's whole degrees F, so its rounding of our own setpoint doesn't nudge the arc
+    float& setpoint = zoneSetpoint(event.zone);
+    if (temperatureCurrent) {
+        podTempF[event.zone] = freeSleepTempF(event.tempCelsius);
+        podTempSequence[event.zone] = event.sequence;
+    }
+    // The pod accepts setpoints beyond the dial's range - keep ours on the arc
+    float podSetpoint = constrain(event.tempCelsius, TEMP_MIN, TEMP_MAX);
+    if (temperatureCurrent && freeSleepTempF(setpoint) != freeSleepTempF(podSetpoint)) {
+        setpoint = podSetpoint;
+        Serial.printf("%s temperature synced: %.1f°C\n", name, setpoint);
+        changed = true;
+    }
+
+    // Only remember the fingerprint once the whole status has been taken on board;
+    // a stale field must be looked at again once the pod has caught up
+    zoneFingerprint[event.zone] = (powerCurrent && temperatureCurrent) ? event.fingerprint : 0;
+
+    return changed;
+}
+
+// Record a discovery answer in the resolution table, then re-check the zone bindings
+void handleControllerFound(const FreeSleepEvent& event) {
+    unsigned long now = millis();
+
+    // Same name, else a free slot, else the one closest to expiring
+    DiscoveredController* slot = nullptr;
+    for (int i = 0; i < FREESLEEP_DISCOVERY_MAX && !slot; i++) {
+        DiscoveredController& entry = discoveredControllers[i];
+        if (entry.valid && strcmp(entry.name, event.name) == 0) slot = &entry;
+    }
+    if (!slot) {
+        slot = &discoveredControllers[0];
+        for (int i = 0; i < FREESLEEP_DISCOVERY_MAX; i++) {
+            DiscoveredController& entry = discoveredControllers[i];
+            if (!entry.valid) {
+                slot = &entry;
+                break;
+            }
+            if ((long)(entry.expiresAt - slot->expiresAt) < 0) slot = &entry;
+        }
+    }
+
+    slot->valid = true;
+    strlcpy(slot->name, event.name, sizeof(slot->name));
+    slot->ip = event.ip;
+    slot->port = event.port;
+    slot->expiresAt = now + FREESLEEP_DISCOVERY_TTL_MS;
+
+    bindZonesToControllers();
+}
+
+// Look up an unexpired table entry by name (or by IP when name is null)
+const DiscoveredController* findDiscoveredController(const char* name, uint32_t ip) {
+    for (int i = 0; i < FREESLEEP_DISCOVERY_MAX; i++) {
+        const DiscoveredController& entry = discoveredControllers[i];
+        if (!entry.valid || (long)(millis() - entry.expiresAt) >= 0) continue;
+        if (name ? strcmp(entry.name, name) == 0 : entry.ip == ip) return &entry;
+    }
+    return nullptr;
+}
+
+// Bound zones follow their controller to a new IP; unbound zones learn the identity at their IP
+void bindZonesToControllers() {
+    for (int i = 0; i < zoneCount; i++) {
+        FreeSleepZone zone = (FreeSleepZone)i;
+        String& name = zoneControllerName(zone);
+        IPAddress& ip = zoneTargetIP(zone);
+
+        if (name.length() > 0) {
+            const DiscoveredController* found = findDiscoveredController(name.c_str(), 0);
+            int other = found ? zoneOnController(IPAddress(found->ip), zone) : -1;
+            if (other >= 0 && found->ip != (uint32_t)ip) {
+                Serial.printf("%s controller %s moved onto %s's address - not followed\n", zoneName(zone),
+                             name.c_str(), zoneName(other));
+            } else if (found && found->ip != (uint32_t)ip) {
+                Serial.printf("%s controller %s moved: %s -> %s\n", zoneName(zone), name.c_str(),
+                             ip.toString().c_str(), IPAddress(found->ip).toString().c_str());
+                ip = IPAddress(found->ip);
+                saveZoneTargetIP(zone);
+                zoneFingerprint[zone] = 0;
+            }
+        } else {
+            const DiscoveredController* found = findDiscoveredController(nullptr, (uint32_t)ip);
+            if (found) {
+                Serial.printf("%s controller identified as %s\n", zoneName(zone), found->name);
+                setZoneController(zone, found->name);
+            }
+        }
+    }
+}
+
+String& zoneControllerName(FreeSleepZone zone) {
+    return zones[zone].controllerName;
+}
+
+void setZoneController(FreeSleepZone zone, const String& name) {
+    zoneControllerName(zone) = name;
+    preferences.putString((zoneKey(zone) + "Host").c_str(), name);
+}
+
+void saveZoneTargetIP(FreeSleepZone zone) {
+    String prefix = zoneKey(zone) + "IP";
+    IPAddress ip = zoneTargetIP(zone);
+    for (int octet = 0; octet < 4; octet++) {
+        preferences.putUChar((prefix + octet).c_str(), ip[octet]);
+    }
+    podTempF[zone] = 0;  // A new address may be a different pod
+}
+
+// Zone table from NVS. The bed and pillow read their original keys and defaults, so a dial
+// upgraded from the two-zone firmware comes up exactly as it was.
+void loadZones() {
+    zoneCount = constrain(preferences.getUChar("zoneCount", 2), 1, MAX_ZONES);
+
+    for (int i = 0; i < MAX_ZONES; i++) {
+        FreeSleepZone zone = (FreeSleepZone)i;
+        Zone& entry = zones[zone];
+        String key = zoneKey(zone);
+
+        const uint8_t defaults[4] = {192, 168, 1, (uint8_t)(zone == ZONE_BED ? 100 : 101)};
+        uint8_t octets[4];
+        for (int octet = 0; octet < 4; octet++) {
+            octets[octet] = preferences.getUChar((key + "IP" + octet).c_str(), zone <= ZONE_PILLOW ? defaults[octet] : 0);
+        }
+        entry.ip = IPAddress(octets[0], octets[1], octets[2], octets[3]);
+        entry.controllerName = preferences.getString((key + "Host").c_str(), "");
+
+        String fallback = zone == ZONE_BED ? "Bed" : zone == ZONE_PILLOW ? "Pillow" : "Zone " + String(zone + 1);
+        strlcpy(entry.name, preferences.getString((key + "Name").c_str(), fallback).c_str(), sizeof(entry.name));
+        entry.setpoint = TEMP_DEFAULT;
+        entry.powerOn = true;
+
+        if (zone < zoneCount) {
+            Serial.printf("Loaded %s IP: %s\n", entry.name, entry.ip.toString().c_str());
+        }
+    }
+}
+
+// Zone count and names; IPs and host names are saved as they change
+void saveZoneLayout() {
+    preferences.putUChar("zoneCount", zoneCount);
+    for (int zone = 0; zone < zoneCount; zone++) {
+        preferences.putString((zoneKey(zone) + "Name").c_str(), zones[zone].name);
+    }
+}
+
+// Stable per-zone key for NVS and JSON: "bed", "pillow", then "zone3", "zone4", ...
+String zoneKey(FreeSleepZone zone) {
+    if (zone == ZONE_BED) return "bed";
+    if (zone == ZONE_PILLOW) return "pillow";
+    return "zone" + String(zone + 1);
+}
+
+float& zoneSetpoint(FreeSleepZone zone) {
+    return zones[zone].setpoint;
+}
+
+bool& zonePowerOn(FreeSleepZone zone) {
+    return zones[zone].powerOn;
+}
+
+IPAddress& zoneTargetIP(FreeSleepZone zone) {
+    return zones[zone].ip;
+}
+
+// Another zone already on this controller, or -1. Every zone drives the same side of its pod,
+// so two zones on one controller would overwrite each other's writes in a single POST.
+int zoneOnController(IPAddress ip, int except) {
+    if ((uint32_t)ip == 0) return -1;
+    for (int zone = 0; zone < zoneCount; zone++) {
+        if (zone != except && zoneTargetIP((FreeSleepZone)zone) == ip) return zone;
+    }
+    return -1;
+}
+
+// A lower zone is on the same controller (a layout saved before duplicates were refused, or a
+// pod that moved onto another zone's address); this zone is left out of syncs and writes
+bool zoneControllerShadowed(FreeSleepZone zone) {
+    int other = zoneOnController(zoneTargetIP(zone), zone);
+    return other >= 0 && other < zone;
+}
+
+const char* zoneName(FreeSleepZone zone) {
+    return zones[zone].name;
+}
+
+const char* activeSide() {
+    return bedSideRight ? "right" : "left";
+}
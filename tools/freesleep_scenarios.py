@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+"""Measure how a dial copes with a misbehaving controller.
+
+Points the dial's bed controller at tools/mock_freesleep.py, runs each fault scenario
+and reports, per scenario:
+
+  sync     time from an out-of-band change on the mock until the dial's /api/bed shows it
+  writes   setpoint bursts sent to the dial; "lost" = the mock never ended on the last value
+  ui       response time of the dial's REST API while the scenario runs - served from the
+           UI loop, so a blocked loop shows up here
+
+Start the mock first, then run against the dial:
+
+  python3 tools/mock_freesleep.py
+  python3 tools/freesleep_scenarios.py --dial 192.168.1.50 --mock-ip 192.168.1.20
+
+Or without hardware, against the host build of the firmware (pio run -e native-net) -
+this starts both the mock and the dial, and exits non-zero if any write was lost or
+any out-of-band change never reached the dial:
+
+  python3 tools/freesleep_scenarios.py --native .pio/build/native-net/program
+
+The dial's bed controller setting is restored afterwards. Uses only the standard library.
+"""
+
+import argparse
+import json
+import os
+import random
+import statistics
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+import urllib.error
+import urllib.request
+
+from mock_freesleep import TARGET_RANGE_F
+
+SCENARIOS = [
+    ("baseline", {}),
+    ("slow pod", {"latency": "lognormal:400"}),
+    ("5xx 20%", {"errorRate": 0.2}),
+    ("resets 20%", {"resetRate": 0.2}),
+    ("truncated 20%", {"truncateRate": 0.2}),
+    ("timeouts 10%", {"timeoutRate": 0.1}),
+    ("everything", {"latency": "20-300", "errorRate": 0.1, "resetRate": 0.1,
+                    "truncateRate": 0.1, "timeoutRate": 0.05}),
+]
+
+NO_FAULTS = {"latency": "0", "timeoutRate": 0, "resetRate": 0, "errorRate": 0, "truncateRate": 0}
+
+MOCK_PORT = 3000  # FREESLEEP_PORT in the firmware
+
+
+def request(method, url, body=None, timeout=5):
+    data = json.dumps(body).encode() if body is not None else None
+    req = urllib.request.Request(url, data=data, method=method, headers={"Content-Type": "application/json"})
+    with urllib.request.urlopen(req, timeout=timeout) as response:
+        payload = response.read()
+        return json.loads(payload) if payload else None
+
+
+def c_to_f(celsius):
+    return round(celsius * 9 / 5 + 32)
+
+
+def percentile(values, pct):
+    if not values:
+        return float("nan")
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * pct / 100))]
+
+
+class UiProbe(threading.Thread):
+    """Times GET /api/temperature on the dial in the background."""
+
+    def __init__(self, dial, interval):
+        super().__init__(daemon=True)
+        self.dial = dial
+        self.interval = interval
+        self.samples = []
+        self.errors = 0
+        self.running = True
+
+    def run(self):
+        while self.running:
+            start = time.monotonic()
+            try:
+                request("GET", f"{self.dial}/api/temperature", timeout=10)
+                self.samples.append((time.monotonic() - start) * 1000)
+            except (urllib.error.URLError, OSError):
+                self.errors += 1
+            time.sleep(self.interval)
+
+
+def measure_sync(args, results):
+    """Out-of-band change on the mock -> visible on the dial."""
+    for _ in range(args.sync_samples):
+        target = random.randint(*TARGET_RANGE_F)
+        # Both sides, so the dial's bed side setting doesn't matter
+        request("POST", f"{args.mock}/mock/state",
+                {"left": {"targetTemperatureF": target}, "right": {"targetTemperatureF": target}})
+        start = time.monotonic()
+        while time.monotonic() - start < args.settle:
+            if c_to_f(request("GET", f"{args.dial}/api/bed")["setpoint"]) == target:
+                results["sync"].append((time.monotonic() - start) * 1000)
+                break
+            time.sleep(0.05)
+        else:
+            results["syncMissed"] += 1
+
+
+def measure_writes(args, results):
+    """Bursts of setpoint changes through the dial; the mock must end on the last one."""
+    for _ in range(args.write_bursts):
+        request("DELETE", f"{args.mock}/mock/writes")
+        values = [random.choice(range(40, 70)) / 2 for _ in range(args.burst_size)]  # 20-34.5°C in 0.5 steps
+        for value in values:
+            request("POST", f"{args.dial}/api/bed", {"setpoint": value})
+            time.sleep(random.uniform(0.05, 0.4))
+
+        expected = c_to_f(values[-1])
+        start = time.monotonic()
+        while time.monotonic() - start < args.settle:
+            posts = request("GET", f"{args.mock}/mock/writes")
+            last = next((side.get("targetTemperatureF") for post in reversed(posts)
+                         for side in post["body"].values()
+                         if isinstance(side, dict) and "targetTemperatureF" in side), None)
+            if last == expected:
+                results["writeConverge"].append((time.monotonic() - start) * 1000)
+                results["posts"].append(len(posts))
+                break
+            time.sleep(0.1)
+        else:
+            results["writesLost"] += 1
+
+
+def run_scenario(args, name, faults):
+    request("POST", f"{args.mock}/mock/faults", {**NO_FAULTS, **faults})
+    results = {"sync": [], "syncMissed": 0, "writeConverge": [], "posts": [], "writesLost": 0}
+
+    probe = UiProbe(args.dial, args.ui_interval)
+    probe.start()
+    try:
+        measure_sync(args, results)
+        measure_writes(args, results)
+    finally:
+        probe.running = False
+        probe.join()
+
+    results["ui"] = probe.samples
+    results["uiErrors"] = probe.errors
+    return results
+
+
+def report(name, results):
+    sync = results["sync"]
+    ui = results["ui"]
+    converge = results["writeConverge"]
+    print(f"{name:<15} "
+          f"sync p50 {percentile(sync, 50):7.0f} p95 {percentile(sync, 95):7.0f} missed {results['syncMissed']:2d} | "
+          f"writes lost {results['writesLost']:2d} converge p95 {percentile(converge, 95):7.0f} "
+          f"posts/burst {statistics.mean(results['posts']) if results['posts'] else float('nan'):4.1f} | "
+          f"ui p50 {percentile(ui, 50):5.0f} p95 {percentile(ui, 95):5.0f} max {max(ui, default=float('nan')):6.0f} "
+          f"err {results['uiErrors']}")
+
+
+def wait_for(url, process, seconds=10):
+    start = time.monotonic()
+    while time.monotonic() - start < seconds:
+        if process.poll() is not None:
+            sys.exit(f"{process.args[0]} exited with {process.returncode}")
+        try:
+            request("GET", url, timeout=1)
+            return
+        except urllib.error.HTTPError:
+            return  # Answering at all is enough
+        except (urllib.error.URLError, OSError):
+            time.sleep(0.1)
+    sys.exit(f"nothing answered on {url}")
+
+
+def start_native(args):
+    """Mock and host-built dial on this machine, logging to a temp dir."""
+    logs = tempfile.mkdtemp(prefix="freesleep-scenarios-")
+    mock_script = os.path.join(os.path.dirname(os.path.abspath(__file__)), "mock_freesleep.py")
+    commands = {"mock": [sys.executable, mock_script, "--port", str(MOCK_PORT)],
+                "dial": [args.native, "--port", str(args.port)]}
+    processes = []
+    for name, command in commands.items():
+        with open(os.path.join(logs, f"{name}.log"), "w") as log:
+            processes.append(subprocess.Popen(command, stdout=log, stderr=subprocess.STDOUT))
+    print(f"logs in {logs}")
+
+    args.mock = f"http://localhost:{MOCK_PORT}"
+    args.mock_ip = "127.0.0.1"
+    args.dial = f"http://localhost:{args.port}"
+    try:
+        wait_for(f"{args.mock}/mock/faults", processes[0])
+        wait_for(f"{args.dial}/api/bed", processes[1])
+    except SystemExit:
+        stop_native(processes)
+        raise
+    return processes
+
+
+def stop_native(processes):
+    for process in processes:
+        process.terminate()
+        process.wait()
+
+
+def run(args):
+    saved = request("GET", f"{args.dial}/api/config/bed-ip")
+    request("POST", f"{args.dial}/api/config/bed-ip", {"ip": args.mock_ip})
+    print("times in ms; sync = out-of-band change -> dial, converge = last dial write -> mock")
+
+    raw = {}
+    try:
+        for name, faults in SCENARIOS:
+            if args.only and args.only not in name:
+                continue
+            raw[name] = run_scenario(args, name, faults)
+            report(name, raw[name])
+    finally:
+        request("POST", f"{args.mock}/mock/faults", NO_FAULTS)
+        if saved.get("host"):
+            request("POST", f"{args.dial}/api/config/bed-ip", {"host": saved["host"]})
+        else:
+            request("POST", f"{args.dial}/api/config/bed-ip", {"ip": saved["ip"]})
+    return raw
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--dial", help="dial IP or URL")
+    parser.add_argument("--mock-ip", help="address the dial should use to reach the mock")
+    parser.add_argument("--mock", default="http://localhost:3000", help="mock URL from this machine")
+    parser.add_argument("--only", help="run only scenarios whose name contains this")
+    parser.add_argument("--sync-samples", type=int, default=5)
+    parser.add_argument("--write-bursts", type=int, default=3)
+    parser.add_argument("--burst-size", type=int, default=5)
+    parser.add_argument("--settle", type=float, default=90, help="seconds to wait for convergence")
+    parser.add_argument("--ui-interval", type=float, default=0.25)
+    parser.add_argument("--json", help="also write raw results to this file")
+    parser.add_argument("--native", metavar="PROGRAM", help="start the mock and this host-built dial locally")
+    parser.add_argument("--port", type=int, default=8080, help="REST port for the --native dial")
+    parser.add_argument("--check", action="store_true",
+                        help="exit 1 if any write was lost or sync missed (implied by --native)")
+    args = parser.parse_args()
+
+    processes = []
+    if args.native:
+        args.check = True
+        processes = start_native(args)
+    elif not args.dial or not args.mock_ip:
+        parser.error("--dial and --mock-ip are required without --native")
+    if not args.dial.startswith("http"):
+        args.dial = f"http://{args.dial}"
+
+    try:
+        raw = run(args)
+    finally:
+        stop_native(processes)
+
+    if args.json:
+        with open(args.json, "w") as out:
+            json.dump(raw, out, indent=2)
+
+    failed = [name for name, results in raw.items() if results["writesLost"] or results["syncMissed"]]
+    if args.check and failed:
+        sys.exit(f"lost writes or missed syncs in: {', '.join(failed)}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,270 @@
+#!/usr/bin/env python3
+"""Local mock of a FreeSleep controller for developing the dial without a pod.
+
+Serves the parts of the API the dial uses on port 3000:
+
+  GET  /api/deviceStatus         current status for both sides
+  POST /api/deviceStatus         merge a partial status, e.g. {"left":{"isOn":true}}
+  GET  /api/deviceStatus/stream  Server-Sent Events - one "data:" event per change
+
+Point the dial's bed/pillow IP at this machine. A change made with curl shows up on
+the dial immediately while the stream is live:
+
+  curl -X POST localhost:3000/api/deviceStatus -d '{"left":{"targetTemperatureF":70}}'
+
+Run with --no-stream to check that the dial falls back to polling.
+
+Faults are injected into deviceStatus GET/POST (not the stream), either from the
+command line or at runtime through the control endpoints:
+
+  --latency 50 | 20-200 | lognormal:100   response delay in ms (fixed, uniform, lognormal median)
+  --timeout-rate 0.1                      hang past the dial's 2s timeout, then close
+  --reset-rate 0.1                        reset the connection without answering
+  --error-rate 0.1                        answer 503
+  --truncate-rate 0.1                     cut the JSON body short
+  --drift 30                              change a setpoint out-of-band every 30s
+
+  GET  /mock/faults       current fault settings      POST /mock/faults  update them
+  POST /mock/state        out-of-band change (not logged as a write)
+  GET  /mock/writes       every POST body received, with timestamps
+  DELETE /mock/writes     clear that log
+
+tools/freesleep_scenarios.py drives a dial against this mock and measures sync latency,
+write loss and UI responsiveness under each fault.
+"""
+
+import argparse
+import copy
+import json
+import math
+import os
+import random
+import re
+import socket
+import struct
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+KEEPALIVE_SECONDS = 15
+TIMEOUT_HANG_SECONDS = 10
+
+
+def target_range_f():
+    """TEMP_MIN..TEMP_MAX from include/config.h in whole °F - the pod clamps anything outside."""
+    config = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "include", "config.h")
+    with open(config) as header:
+        text = header.read()
+    limits = [float(re.search(rf"#define {name} ([\d.]+)", text).group(1)) for name in ("TEMP_MIN", "TEMP_MAX")]
+    return math.ceil(limits[0] * 9 / 5 + 32), math.floor(limits[1] * 9 / 5 + 32)
+
+
+TARGET_RANGE_F = target_range_f()
+
+state_lock = threading.Condition()
+state_version = 0
+state = {
+    "left": {"currentTemperatureF": 80, "targetTemperatureF": 80, "secondsRemaining": 0, "isOn": True},
+    "right": {"currentTemperatureF": 80, "targetTemperatureF": 80, "secondsRemaining": 0, "isOn": True},
+    "waterLevel": "true",
+    "isPriming": False,
+}
+
+faults = {
+    "latency": "0",
+    "timeoutRate": 0.0,
+    "resetRate": 0.0,
+    "errorRate": 0.0,
+    "truncateRate": 0.0,
+}
+writes = []  # {"t": epoch seconds, "body": {...}}
+
+
+def merge(target, update):
+    for key, value in update.items():
+        if isinstance(value, dict) and isinstance(target.get(key), dict):
+            merge(target[key], value)
+        else:
+            target[key] = value
+
+
+def apply_update(update):
+    global state_version
+    with state_lock:
+        merge(state, update)
+        state_version += 1
+        state_lock.notify_all()
+
+
+def latency_seconds(spec):
+    spec = str(spec)
+    if spec.startswith("lognormal:"):
+        median = float(spec.split(":", 1)[1])
+        return random.lognormvariate(math.log(max(median, 1)), 0.5) / 1000
+    if "-" in spec:
+        low, high = (float(part) for part in spec.split("-", 1))
+        return random.uniform(low, high) / 1000
+    return float(spec) / 1000
+
+
+def chance(rate):
+    return random.random() < float(rate)
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"  # Keep-alive, like the pod
+    streaming = True
+
+    def send_json(self, code, body=None, truncate=False):
+        payload = json.dumps(body).encode() if body is not None else b""
+        self.send_response(code)
+        if body is not None:
+            self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(payload)))
+        self.end_headers()
+        if truncate:
+            self.wfile.write(payload[: len(payload) // 2])
+            self.wfile.flush()
+            self.close_connection = True
+        else:
+            self.wfile.write(payload)
+
+    def inject_faults(self):
+        """Apply the configured faults. Returns True if the request was consumed by one."""
+        time.sleep(latency_seconds(faults["latency"]))
+        if chance(faults["timeoutRate"]):
+            time.sleep(TIMEOUT_HANG_SECONDS)
+            self.close_connection = True
+            return True
+        if chance(faults["resetRate"]):
+            # SO_LINGER 0 turns close() into a TCP reset
+            self.connection.setsockopt(socket.SOL_SOCKET, socket.SO_LINGER, struct.pack("ii", 1, 0))
+            self.close_connection = True
+            return True
+        if chance(faults["errorRate"]):
+            self.send_json(503, {"error": "injected"})
+            return True
+        return False
+
+    def read_json(self):
+        length = int(self.headers.get("Content-Length", 0))
+        try:
+            return json.loads(self.rfile.read(length) or b"{}")
+        except ValueError:
+            return None
+
+    def do_GET(self):
+        if self.path == "/api/deviceStatus":
+            if self.inject_faults():
+                return
+            with state_lock:
+                body = copy.deepcopy(state)
+            self.send_json(200, body, truncate=chance(faults["truncateRate"]))
+        elif self.path == "/api/deviceStatus/stream" and self.streaming:
+            self.stream()
+        elif self.path == "/mock/faults":
+            self.send_json(200, faults)
+        elif self.path == "/mock/writes":
+            self.send_json(200, writes)
+        else:
+            self.send_json(404, {"error": "not found"})
+
+    def do_POST(self):
+        update = self.read_json()
+        if update is None:
+            self.send_json(400, {"error": "invalid JSON"})
+            return
+
+        if self.path == "/api/deviceStatus":
+            if self.inject_faults():
+                return
+            print(f"POST {json.dumps(update)}", flush=True)
+            writes.append({"t": time.time(), "body": update})
+            apply_update(update)
+            self.send_json(204)
+        elif self.path == "/mock/state":
+            apply_update(update)
+            self.send_json(204)
+        elif self.path == "/mock/faults":
+            faults.update({key: value for key, value in update.items() if key in faults})
+            print(f"faults {json.dumps(faults)}", flush=True)
+            self.send_json(200, faults)
+        else:
+            self.send_json(404, {"error": "not found"})
+
+    def do_DELETE(self):
+        if self.path == "/mock/writes":
+            writes.clear()
+            self.send_json(204)
+        else:
+            self.send_json(404, {"error": "not found"})
+
+    def stream(self):
+        # No Content-Length: the body runs until the connection closes
+        self.send_response(200)
+        self.send_header("Content-Type", "text/event-stream")
+        self.send_header("Cache-Control", "no-cache")
+        self.send_header("Connection", "close")
+        self.end_headers()
+        self.close_connection = True
+        print(f"stream opened by {self.client_address[0]}", flush=True)
+
+        seen = -1
+        try:
+            while True:
+                with state_lock:
+                    if seen == state_version:
+                        state_lock.wait(KEEPALIVE_SECONDS)
+                    changed = seen != state_version
+                    seen = state_version
+                    body = json.dumps(state)
+                self.wfile.write(f"data: {body}\n\n".encode() if changed else b": keep-alive\n\n")
+                self.wfile.flush()
+        except (BrokenPipeError, ConnectionResetError):
+            print(f"stream closed by {self.client_address[0]}", flush=True)
+
+    def log_message(self, fmt, *args):
+        pass
+
+
+def drift(interval):
+    """Out-of-band changes, as if someone used the FreeSleep app."""
+    while True:
+        time.sleep(interval)
+        side = random.choice(["left", "right"])
+        target = random.randint(*TARGET_RANGE_F)
+        print(f"drift {side} -> {target}F", flush=True)
+        apply_update({side: {"targetTemperatureF": target}})
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", type=int, default=3000)
+    parser.add_argument("--no-stream", action="store_true", help="404 the event stream (polling only)")
+    parser.add_argument("--latency", default="0")
+    parser.add_argument("--timeout-rate", type=float, default=0.0)
+    parser.add_argument("--reset-rate", type=float, default=0.0)
+    parser.add_argument("--error-rate", type=float, default=0.0)
+    parser.add_argument("--truncate-rate", type=float, default=0.0)
+    parser.add_argument("--drift", type=float, default=0, help="seconds between out-of-band changes (0 = off)")
+    args = parser.parse_args()
+
+    faults.update({
+        "latency": args.latency,
+        "timeoutRate": args.timeout_rate,
+        "resetRate": args.reset_rate,
+        "errorRate": args.error_rate,
+        "truncateRate": args.truncate_rate,
+    })
+    if args.drift > 0:
+        threading.Thread(target=drift, args=(args.drift,), daemon=True).start()
+
+    Handler.streaming = not args.no_stream
+    server = ThreadingHTTPServer(("", args.port), Handler)
+    server.daemon_threads = True
+    print(f"Mock FreeSleep controller on :{args.port} (stream {'off' if args.no_stream else 'on'})", flush=True)
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()